@@ -14,6 +14,8 @@ set_property(GLOBAL PROPERTY USE_FOLDERS ON)
 
 option(Jam_BUILD_TEST "Build the unit test program." ON)
 option(Jam_AUTO_RUN_TEST "Automatically run the test program." OFF)
+option(Jam_BUILD_BENCH "Build the benchmark program." OFF)
+option(Jam_EQ_JIT "Compile pure expressions to native x86-64 code." ON)
 option(Jam_Window_GL_REGENERATE "Regenerate the OpenGL API from the Extras/OpenGL.py dictionary." OFF)
 option(Jam_JUST_MY_CODE "Enable the /JMC flag" ON)
 option(Jam_USE_STATIC_RUNTIME  "Build with the MultiThreaded(Debug) runtime library." ON)
@@ -34,6 +36,9 @@ else()
 endif()
 
 set(Jam_GLOBAL_DEFINE -DSDL_MAIN_HANDLED)
+if (Jam_EQ_JIT)
+    list(APPEND Jam_GLOBAL_DEFINE -DJAM_EQ_JIT=1)
+endif ()
 
 # Global icon source
 set(Jam_IconSource 
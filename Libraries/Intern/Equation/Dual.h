@@ -0,0 +1,203 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+#include "Equation/Program.h"
+
+namespace Jam::Eq
+{
+    /**
+     * \brief A value together with its derivative with respect to one
+     * variable, so that evaluating an expression on duals yields f(x)
+     * and f'(x) in a single pass.
+     *
+     * Values are computed the same way the interpreter computes them.
+     * Derivatives are exact, except at the jumps of floor, ceil and the
+     * modulo operations, where the one sided derivative is used.
+     */
+    struct Dual
+    {
+        R64 v{0};
+        R64 d{0};
+    };
+
+    using DualArray = SimpleArray<Dual>;
+
+    constexpr R64 Ln10 = 2.3025850929940456840179914546844;
+
+    inline Dual duConst(const R64 v)
+    {
+        return {v, 0};
+    }
+
+    inline Dual duAdd(const Dual& a, const Dual& b)
+    {
+        return {a.v + b.v, a.d + b.d};
+    }
+
+    inline Dual duSub(const Dual& a, const Dual& b)
+    {
+        return {a.v - b.v, a.d - b.d};
+    }
+
+    inline Dual duMul(const Dual& a, const Dual& b)
+    {
+        return {a.v * b.v, a.d * b.v + a.v * b.d};
+    }
+
+    inline Dual duDiv(const Dual& a, const Dual& b)
+    {
+        if (!(fabs(b.v) > DBL_EPSILON))
+            return {NAN, NAN};
+
+        const R64 r = 1.0 / b.v;
+        const R64 v = a.v * r;
+        return {v, (a.d - v * b.d) * r};
+    }
+
+    inline Dual duPow(const Dual& a, const Dual& b)
+    {
+        const R64 v = ::pow(a.v, b.v);
+
+        // each term is skipped when its factor is constant, so that
+        // x^2 has a slope for negative x and 2^x has one at zero
+        R64 d = 0;
+        if (a.d != 0)
+            d += b.v * ::pow(a.v, b.v - 1) * a.d;
+        if (b.d != 0)
+            d += v * log(a.v) * b.d;
+        return {v, d};
+    }
+
+    inline Dual duMod(const Dual& a, const Dual& b)
+    {
+        const R64 v = fmod(a.v, b.v);
+        return {v, a.d - trunc(a.v / b.v) * b.d};
+    }
+
+    inline Dual duFmod(const Dual& a, const Dual& b)
+    {
+        // lMod(a, b) is a - q * b for a whole q
+        const R64 v = lMod(a.v, b.v);
+        return {v, a.d - round((a.v - v) / b.v) * b.d};
+    }
+
+    inline Dual duAtan2(const Dual& a, const Dual& b)
+    {
+        return {atan2(a.v, b.v),
+                (b.v * a.d - a.v * b.d) / (a.v * a.v + b.v * b.v)};
+    }
+
+    inline Dual duNeg(const Dual& a)
+    {
+        return {-a.v, -a.d};
+    }
+
+    inline Dual duSqr(const Dual& a)
+    {
+        return {a.v * a.v, 2 * a.v * a.d};
+    }
+
+    inline Dual duAbs(const Dual& a)
+    {
+        return {fabs(a.v), a.v < 0 ? -a.d : a.d};
+    }
+
+    inline Dual duAcos(const Dual& a)
+    {
+        return {acos(a.v), -a.d / sqrt(1 - a.v * a.v)};
+    }
+
+    inline Dual duAsin(const Dual& a)
+    {
+        return {asin(a.v), a.d / sqrt(1 - a.v * a.v)};
+    }
+
+    inline Dual duAtan(const Dual& a)
+    {
+        return {atan(a.v), a.d / (1 + a.v * a.v)};
+    }
+
+    inline Dual duCeil(const Dual& a)
+    {
+        return {ceil(a.v), 0};
+    }
+
+    inline Dual duCos(const Dual& a)
+    {
+        return {cos(a.v), -sin(a.v) * a.d};
+    }
+
+    inline Dual duCosh(const Dual& a)
+    {
+        return {cosh(a.v), sinh(a.v) * a.d};
+    }
+
+    inline Dual duExp(const Dual& a)
+    {
+        const R64 v = exp(a.v);
+        return {v, v * a.d};
+    }
+
+    inline Dual duFloor(const Dual& a)
+    {
+        return {floor(a.v), 0};
+    }
+
+    inline Dual duLog(const Dual& a)
+    {
+        return {log(a.v), a.d / a.v};
+    }
+
+    inline Dual duLog10(const Dual& a)
+    {
+        return {log10(a.v), a.d / (a.v * Ln10)};
+    }
+
+    inline Dual duSin(const Dual& a)
+    {
+        return {sin(a.v), cos(a.v) * a.d};
+    }
+
+    inline Dual duSinh(const Dual& a)
+    {
+        return {sinh(a.v), cosh(a.v) * a.d};
+    }
+
+    inline Dual duSqrt(const Dual& a)
+    {
+        const R64 v = sqrt(a.v);
+        return {v, a.d / (2 * v)};
+    }
+
+    inline Dual duTan(const Dual& a)
+    {
+        const R64 v = tan(a.v);
+        return {v, (1 + v * v) * a.d};
+    }
+
+    inline Dual duTanh(const Dual& a)
+    {
+        const R64 v = tanh(a.v);
+        return {v, (1 - v * v) * a.d};
+    }
+
+}  // namespace Jam::Eq
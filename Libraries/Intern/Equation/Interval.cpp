@@ -0,0 +1,471 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Equation/Interval.h"
+#include <cfloat>
+#include <cmath>
+
+namespace Jam::Eq
+{
+    namespace
+    {
+        constexpr R64 TwoPi64  = 2 * Pi64;
+        constexpr R64 HalfPi64 = Pi64 / 2;
+
+        R64 down(const R64 v)
+        {
+            return nextafter(v, -INFINITY);
+        }
+
+        R64 up(const R64 v)
+        {
+            return nextafter(v, INFINITY);
+        }
+
+        // [lo, hi] rounded outward by one unit in the last place, which
+        // covers the rounding of the arithmetic and of the math library.
+        // Undefined bounds can only come from infinite operands here.
+        Interval make(const R64       lo,
+                      const R64       hi,
+                      const Interval& a,
+                      const Interval& b)
+        {
+            return {
+                std::isnan(lo) ? -INFINITY : down(lo),
+                std::isnan(hi) ? INFINITY : up(hi),
+                a.defined && b.defined,
+                a.continuous && b.continuous,
+            };
+        }
+
+        Interval make(const R64 lo, const R64 hi, const Interval& a)
+        {
+            return make(lo, hi, a, a);
+        }
+
+        // Marks r as having a jump, or a gap if defined is false.
+        Interval broken(Interval r, const bool defined = true)
+        {
+            r.continuous = false;
+            r.defined    = r.defined && defined;
+            return r;
+        }
+
+        bool contains(const Interval& a, const R64 v)
+        {
+            return a.lo <= v && v <= a.hi;
+        }
+
+        bool isPoint(const Interval& a)
+        {
+            return a.lo == a.hi;
+        }
+
+        // Zero times anything is zero, so infinite bounds stay ordered.
+        R64 mul(const R64 a, const R64 b)
+        {
+            return a == 0 || b == 0 ? 0 : a * b;
+        }
+
+        // True if a contains at + 2πk for some k. A peak that is missed
+        // through rounding is within an ulp of an end, where the function
+        // is flat, so the end value is still within the rounded bounds.
+        bool hasPeak(const Interval& a, const R64 at, const R64 period)
+        {
+            return at + ceil((a.lo - at) / period) * period <= a.hi;
+        }
+
+        Interval minMax(const R64       p,
+                        const R64       q,
+                        const Interval& a,
+                        const Interval& b)
+        {
+            return make(Min(p, q), Max(p, q), a, b);
+        }
+
+        Interval minMax(const R64 p, const R64 q, const Interval& a)
+        {
+            return minMax(p, q, a, a);
+        }
+
+        Interval corners(R64 (*fn)(R64, R64), const Interval& a, const Interval& b)
+        {
+            const R64 c[4] = {
+                fn(a.lo, b.lo),
+                fn(a.lo, b.hi),
+                fn(a.hi, b.lo),
+                fn(a.hi, b.hi),
+            };
+            return make(Min(Min(c[0], c[1]), Min(c[2], c[3])),
+                        Max(Max(c[0], c[1]), Max(c[2], c[3])),
+                        a,
+                        b);
+        }
+
+    }  // namespace
+
+    Interval ivPoint(const R64 v)
+    {
+        if (std::isnan(v))
+            return ivEmpty();
+        return {v, v};
+    }
+
+    Interval ivRange(const R64 lo, const R64 hi)
+    {
+        return {Min(lo, hi), Max(lo, hi)};
+    }
+
+    Interval ivUnbounded()
+    {
+        return {-INFINITY, INFINITY, false, false};
+    }
+
+    Interval ivEmpty()
+    {
+        return {NAN, NAN, false, false};
+    }
+
+    bool ivIsEmpty(const Interval& a)
+    {
+        return std::isnan(a.lo) || std::isnan(a.hi);
+    }
+
+    bool ivIsBounded(const Interval& a)
+    {
+        return a.continuous && std::isfinite(a.lo) && std::isfinite(a.hi);
+    }
+
+    Interval ivAdd(const Interval& a, const Interval& b)
+    {
+        if (ivIsEmpty(a) || ivIsEmpty(b))
+            return ivEmpty();
+        return make(a.lo + b.lo, a.hi + b.hi, a, b);
+    }
+
+    Interval ivSub(const Interval& a, const Interval& b)
+    {
+        if (ivIsEmpty(a) || ivIsEmpty(b))
+            return ivEmpty();
+        return make(a.lo - b.hi, a.hi - b.lo, a, b);
+    }
+
+    Interval ivMul(const Interval& a, const Interval& b)
+    {
+        if (ivIsEmpty(a) || ivIsEmpty(b))
+            return ivEmpty();
+        return corners(mul, a, b);
+    }
+
+    Interval ivDiv(const Interval& a, const Interval& b)
+    {
+        if (ivIsEmpty(a) || ivIsEmpty(b))
+            return ivEmpty();
+
+        // the interpreter yields NaN within DBL_EPSILON of zero
+        if (b.lo >= -DBL_EPSILON && b.hi <= DBL_EPSILON)
+            return ivEmpty();
+        if (b.lo <= DBL_EPSILON && b.hi >= -DBL_EPSILON)
+            return ivUnbounded();
+
+        const Interval r = make(1.0 / b.hi, 1.0 / b.lo, b);
+        return ivMul(a, r);
+    }
+
+    Interval ivPow(const Interval& a, const Interval& b)
+    {
+        if (ivIsEmpty(a) || ivIsEmpty(b))
+            return ivEmpty();
+
+        if (!isPoint(b))
+        {
+            // x^y is monotone in both for a positive base
+            if (a.lo > 0)
+                return corners(::pow, a, b);
+            return ivUnbounded();
+        }
+
+        const R64 n = b.lo;
+        if (n == 0)
+            return make(1, 1, a);
+
+        if (n == floor(n) && fabs(n) < 0x1p53)
+        {
+            const R64  p    = ::pow(a.lo, n);
+            const R64  q    = ::pow(a.hi, n);
+            const bool even = fmod(n, 2) == 0;
+
+            if (!contains(a, 0))
+                return minMax(p, q, a);
+            if (n > 0)
+                return even ? make(0, Max(p, q), a) : minMax(p, q, a);
+
+            // negative powers have a pole at zero
+            if (isPoint(a))
+                return ivEmpty();
+            return ivUnbounded();
+        }
+
+        // fractional powers are undefined for a negative base
+        if (a.hi < 0)
+            return ivEmpty();
+
+        const R64 lo = Max(a.lo, 0.0);
+        const R64 p  = ::pow(lo, n);
+        const R64 q  = ::pow(a.hi, n);
+
+        Interval r = minMax(p, q, a);
+        if (a.lo < 0 || !std::isfinite(p))
+            r = broken(r, false);
+        return r;
+    }
+
+    Interval ivMod(const Interval& a, const Interval& b)
+    {
+        if (ivIsEmpty(a) || ivIsEmpty(b))
+            return ivEmpty();
+
+        const R64 m = Max(fabs(b.lo), fabs(b.hi));
+        if (m == 0)
+            return ivEmpty();
+
+        if (isPoint(b))
+        {
+            // fmod(x, m) is x - trunc(x / m) * m, linear between multiples
+            const R64 q = trunc(a.lo / m);
+            if (q == trunc(a.hi / m))
+                return make(a.lo - q * m, a.hi - q * m, a);
+        }
+
+        // the result takes the sign of a and is smaller than both
+        const R64 r  = Min(m, Max(fabs(a.lo), fabs(a.hi)));
+        Interval  rv = make(a.lo >= 0 ? 0 : -r, a.hi <= 0 ? 0 : r, a, b);
+        return broken(rv, !contains(b, 0));
+    }
+
+    Interval ivFmod(const Interval& a, const Interval& b)
+    {
+        if (ivIsEmpty(a) || ivIsEmpty(b))
+            return ivEmpty();
+
+        if (isPoint(b) && b.lo > 0)
+        {
+            // lMod is floored, in [0, k) and linear between multiples
+            const R64 k = b.lo;
+            const R64 q = floor(a.lo / k);
+            if (q == floor(a.hi / k))
+                return make(a.lo - q * k, a.hi - q * k, a);
+            return broken(make(0, k, a));
+        }
+
+        // remainder is within half of |b|, lMod adds b when it is negative
+        const R64 m = Max(fabs(b.lo), fabs(b.hi));
+        if (m == 0)
+            return ivEmpty();
+        const Interval r = make(Min(0.0, b.lo) - m * 0.5,
+                                Max(0.0, b.hi) + m * 0.5,
+                                a,
+                                b);
+        return broken(r, !contains(b, 0));
+    }
+
+    Interval ivAtan2(const Interval& a, const Interval& b)
+    {
+        if (ivIsEmpty(a) || ivIsEmpty(b))
+            return ivEmpty();
+
+        // away from the branch cut on the negative x axis atan2 is
+        // monotone in each argument, so the corners bound it
+        if (b.lo > 0 || a.lo > 0 || a.hi < 0)
+            return corners(::atan2, a, b);
+        return broken(make(-Pi64, Pi64, a, b));
+    }
+
+    Interval ivNeg(const Interval& a)
+    {
+        if (ivIsEmpty(a))
+            return ivEmpty();
+        return {-a.hi, -a.lo, a.defined, a.continuous};
+    }
+
+    Interval ivSqr(const Interval& a)
+    {
+        return ivPow(a, ivPoint(2));
+    }
+
+    Interval ivAbs(const Interval& a)
+    {
+        if (ivIsEmpty(a))
+            return ivEmpty();
+        if (a.lo >= 0)
+            return a;
+        if (a.hi <= 0)
+            return ivNeg(a);
+        return {0, Max(-a.lo, a.hi), a.defined, a.continuous};
+    }
+
+    Interval ivAcos(const Interval& a)
+    {
+        if (ivIsEmpty(a) || a.hi < -1 || a.lo > 1)
+            return ivEmpty();
+
+        const Interval r = make(acos(Min(a.hi, 1.0)), acos(Max(a.lo, -1.0)), a);
+        return a.lo < -1 || a.hi > 1 ? broken(r, false) : r;
+    }
+
+    Interval ivAsin(const Interval& a)
+    {
+        if (ivIsEmpty(a) || a.hi < -1 || a.lo > 1)
+            return ivEmpty();
+
+        const Interval r = make(asin(Max(a.lo, -1.0)), asin(Min(a.hi, 1.0)), a);
+        return a.lo < -1 || a.hi > 1 ? broken(r, false) : r;
+    }
+
+    Interval ivAtan(const Interval& a)
+    {
+        if (ivIsEmpty(a))
+            return ivEmpty();
+        return make(atan(a.lo), atan(a.hi), a);
+    }
+
+    Interval ivCeil(const Interval& a)
+    {
+        if (ivIsEmpty(a))
+            return ivEmpty();
+
+        const Interval r = {ceil(a.lo), ceil(a.hi), a.defined, a.continuous};
+        return r.lo != r.hi ? broken(r) : r;
+    }
+
+    Interval ivCos(const Interval& a)
+    {
+        if (ivIsEmpty(a))
+            return ivEmpty();
+        if (!(a.hi - a.lo < TwoPi64))
+            return make(-1, 1, a);
+
+        Interval r = minMax(cos(a.lo), cos(a.hi), a);
+        if (hasPeak(a, 0, TwoPi64))
+            r.hi = 1;
+        if (hasPeak(a, Pi64, TwoPi64))
+            r.lo = -1;
+        return r;
+    }
+
+    Interval ivCosh(const Interval& a)
+    {
+        if (ivIsEmpty(a))
+            return ivEmpty();
+
+        const R64 p = cosh(a.lo);
+        const R64 q = cosh(a.hi);
+        if (contains(a, 0))
+            return make(1, Max(p, q), a);
+        return minMax(p, q, a);
+    }
+
+    Interval ivExp(const Interval& a)
+    {
+        if (ivIsEmpty(a))
+            return ivEmpty();
+        return make(exp(a.lo), exp(a.hi), a);
+    }
+
+    Interval ivFloor(const Interval& a)
+    {
+        if (ivIsEmpty(a))
+            return ivEmpty();
+
+        const Interval r = {floor(a.lo), floor(a.hi), a.defined, a.continuous};
+        return r.lo != r.hi ? broken(r) : r;
+    }
+
+    Interval ivLog(const Interval& a)
+    {
+        if (ivIsEmpty(a) || a.hi <= 0)
+            return ivEmpty();
+        if (a.lo <= 0)
+            return broken(make(-INFINITY, log(a.hi), a), false);
+        return make(log(a.lo), log(a.hi), a);
+    }
+
+    Interval ivLog10(const Interval& a)
+    {
+        if (ivIsEmpty(a) || a.hi <= 0)
+            return ivEmpty();
+        if (a.lo <= 0)
+            return broken(make(-INFINITY, log10(a.hi), a), false);
+        return make(log10(a.lo), log10(a.hi), a);
+    }
+
+    Interval ivSin(const Interval& a)
+    {
+        if (ivIsEmpty(a))
+            return ivEmpty();
+        if (!(a.hi - a.lo < TwoPi64))
+            return make(-1, 1, a);
+
+        Interval r = minMax(sin(a.lo), sin(a.hi), a);
+        if (hasPeak(a, HalfPi64, TwoPi64))
+            r.hi = 1;
+        if (hasPeak(a, -HalfPi64, TwoPi64))
+            r.lo = -1;
+        return r;
+    }
+
+    Interval ivSinh(const Interval& a)
+    {
+        if (ivIsEmpty(a))
+            return ivEmpty();
+        return make(sinh(a.lo), sinh(a.hi), a);
+    }
+
+    Interval ivSqrt(const Interval& a)
+    {
+        if (ivIsEmpty(a) || a.hi < 0)
+            return ivEmpty();
+        if (a.lo < 0)
+            return broken(make(0, sqrt(a.hi), a), false);
+        return make(sqrt(a.lo), sqrt(a.hi), a);
+    }
+
+    Interval ivTan(const Interval& a)
+    {
+        if (ivIsEmpty(a))
+            return ivEmpty();
+
+        // tan increases between poles, so a decrease means one was crossed
+        const R64 p = tan(a.lo);
+        const R64 q = tan(a.hi);
+        if (!(a.hi - a.lo < Pi64) || hasPeak(a, HalfPi64, Pi64) || p > q)
+            return ivUnbounded();
+        return make(p, q, a);
+    }
+
+    Interval ivTanh(const Interval& a)
+    {
+        if (ivIsEmpty(a))
+            return ivEmpty();
+        return make(tanh(a.lo), tanh(a.hi), a);
+    }
+
+}  // namespace Jam::Eq
@@ -0,0 +1,95 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+#include "Math/Real.h"
+#include "Utils/Array.h"
+
+namespace Jam::Eq
+{
+    /**
+     * \brief A closed range of values that encloses every result an
+     * expression can produce over a range of inputs.
+     *
+     * Bounds are rounded outward, so the true results always lie inside.
+     * NaN bounds mark an empty interval, one where the expression is
+     * undefined at every input.
+     */
+    struct Interval
+    {
+        R64 lo{0};
+        R64 hi{0};
+
+        // Every input of the range produces a value.
+        bool defined{true};
+
+        // The result has no jumps over the range, implies defined.
+        bool continuous{true};
+    };
+
+    using IntervalArray = SimpleArray<Interval>;
+
+    Interval ivPoint(R64 v);
+
+    Interval ivRange(R64 lo, R64 hi);
+
+    // [-inf, inf], for results that cannot be bounded.
+    Interval ivUnbounded();
+
+    Interval ivEmpty();
+
+    bool ivIsEmpty(const Interval& a);
+
+    // True if a is continuous and has finite bounds.
+    bool ivIsBounded(const Interval& a);
+
+    // Interval forms of the interpreter's operations. Each one follows
+    // the matching case of Program::evaluate, including division
+    // by values within DBL_EPSILON of zero being undefined.
+
+    Interval ivAdd(const Interval& a, const Interval& b);
+    Interval ivSub(const Interval& a, const Interval& b);
+    Interval ivMul(const Interval& a, const Interval& b);
+    Interval ivDiv(const Interval& a, const Interval& b);
+    Interval ivPow(const Interval& a, const Interval& b);
+    Interval ivMod(const Interval& a, const Interval& b);
+    Interval ivFmod(const Interval& a, const Interval& b);
+    Interval ivAtan2(const Interval& a, const Interval& b);
+    Interval ivNeg(const Interval& a);
+    Interval ivSqr(const Interval& a);
+    Interval ivAbs(const Interval& a);
+    Interval ivAcos(const Interval& a);
+    Interval ivAsin(const Interval& a);
+    Interval ivAtan(const Interval& a);
+    Interval ivCeil(const Interval& a);
+    Interval ivCos(const Interval& a);
+    Interval ivCosh(const Interval& a);
+    Interval ivExp(const Interval& a);
+    Interval ivFloor(const Interval& a);
+    Interval ivLog(const Interval& a);
+    Interval ivLog10(const Interval& a);
+    Interval ivSin(const Interval& a);
+    Interval ivSinh(const Interval& a);
+    Interval ivSqrt(const Interval& a);
+    Interval ivTan(const Interval& a);
+    Interval ivTanh(const Interval& a);
+
+}  // namespace Jam::Eq
@@ -0,0 +1,63 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Equation/NameTable.h"
+
+namespace Jam::Eq
+{
+    U32 NameTable::find(const StringView name) const
+    {
+        if (const size_t idx = _lookup.find(Hash(name.data(), name.size()));
+            idx != JtNpos)
+        {
+            // the table only compares hashes
+            if (const U32 loc = _lookup.at(idx); _names[loc] == name)
+                return loc;
+
+            for (U32 i = 0; i < (U32)_names.size(); ++i)
+            {
+                if (_names[i] == name)
+                    return i;
+            }
+        }
+        return JtNpos32;
+    }
+
+    U32 NameTable::intern(const StringView name)
+    {
+        if (const U32 idx = find(name); idx != JtNpos32)
+            return idx;
+
+        const U32 idx = (U32)_names.size();
+        _names.emplace_back(name);
+
+        // a colliding name is only reachable through the scan in find
+        _lookup.insert(Hash(name.data(), name.size()), idx);
+        return idx;
+    }
+
+    void NameTable::clear()
+    {
+        _names.clear();
+        _lookup.clear();
+    }
+
+}  // namespace Jam::Eq
@@ -0,0 +1,67 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+#include "Utils/HashMap.h"
+#include "Utils/String.h"
+
+namespace Jam::Eq
+{
+    /**
+     * \brief Interns identifier names so that symbols can refer to them
+     * by index.
+     *
+     * Entries are never removed individually, so an index stays valid
+     * until the table is cleared.
+     */
+    class NameTable
+    {
+    private:
+        StringArray            _names;
+        HashTable<hash_t, U32> _lookup;
+
+    public:
+        NameTable() = default;
+
+        // Returns the index of name, adding it if needed.
+        U32 intern(StringView name);
+
+        // Returns the index of name or JtNpos32.
+        U32 find(StringView name) const;
+
+        const String& at(U32 idx) const;
+
+        U32 size() const;
+
+        void clear();
+    };
+
+    inline const String& NameTable::at(const U32 idx) const
+    {
+        return _names.at(idx);
+    }
+
+    inline U32 NameTable::size() const
+    {
+        return (U32)_names.size();
+    }
+
+}  // namespace Jam::Eq
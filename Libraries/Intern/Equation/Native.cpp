@@ -0,0 +1,810 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Equation/Native.h"
+#include <cmath>
+#include <cstring>
+
+#if JAM_EQ_NATIVE
+    #include <emmintrin.h>
+    #ifdef _WIN32
+        #define WIN32_LEAN_AND_MEAN
+        #include <Windows.h>
+    #else
+        #include <sys/mman.h>
+        #include <unistd.h>
+    #endif
+#endif
+
+namespace Jam::Eq
+{
+    namespace
+    {
+        // Called from the generated code with a pointer to the row of the
+        // destination register, the second operand is in the next row.
+        // The results of both lanes are returned in xmm0. Each mirrors its
+        // case in Statement::executeImpl.
+
+#if JAM_EQ_NATIVE
+        using Pair = __m128d;
+
+        Pair pair(const R64 lo, const R64 hi)
+        {
+            return _mm_set_pd(hi, lo);
+        }
+#else
+        struct Pair
+        {
+            R64 lo, hi;
+        };
+
+        Pair pair(const R64 lo, const R64 hi)
+        {
+            return {lo, hi};
+        }
+#endif
+
+        // clang-format off
+        R64 nPow(const R64 a, const R64 b)   { return ::pow(a, b); }
+        R64 nMod(const R64 a, const R64 b)   { return fmod(a, b); }
+        R64 nAtan2(const R64 a, const R64 b) { return atan2(a, b); }
+        R64 nFmod(const R64 a, const R64 b)  { return lMod(a, b); }
+        R64 nAcos(const R64 a)               { return acos(a); }
+        R64 nAsin(const R64 a)               { return asin(a); }
+        R64 nAtan(const R64 a)               { return atan(a); }
+        R64 nCeil(const R64 a)               { return ceil(a); }
+        R64 nCos(const R64 a)                { return cos(a); }
+        R64 nCosh(const R64 a)               { return cosh(a); }
+        R64 nExp(const R64 a)                { return exp(a); }
+        R64 nFloor(const R64 a)              { return floor(a); }
+        R64 nLog(const R64 a)                { return log(a); }
+        R64 nLog10(const R64 a)              { return log10(a); }
+        R64 nSin(const R64 a)                { return sin(a); }
+        R64 nSinh(const R64 a)               { return sinh(a); }
+        R64 nTan(const R64 a)                { return tan(a); }
+        R64 nTanh(const R64 a)               { return tanh(a); }
+        // clang-format on
+
+        template <R64 (*Fn)(R64)>
+        Pair rowUnary(const R64* d)
+        {
+            return pair(Fn(d[0]), Fn(d[1]));
+        }
+
+        template <R64 (*Fn)(R64, R64)>
+        Pair rowBinary(const R64* d)
+        {
+            return pair(Fn(d[0], d[2]), Fn(d[1], d[3]));
+        }
+
+        Pair rowPowK(const R64* d, const R64* k)
+        {
+            return pair(::pow(d[0], *k), ::pow(d[1], *k));
+        }
+
+        enum OperandKind
+        {
+            KindXmm,
+            KindSpill,     // [rbx + disp32]
+            KindVariable,  // [rbp + disp32]
+            KindConstant,  // [rip + disp32], into the constant pool
+            KindSample,    // [r12]
+            KindResult,    // [r13]
+        };
+
+        // Values are allocated to xmm2 to xmm15, xmm0 and xmm1 are scratch.
+        constexpr U8 FirstXmm = 2;
+
+        // 66 0F packed double opcodes
+        constexpr U8 PdLoad   = 0x10;  // movupd xmm, m
+        constexpr U8 PdStore  = 0x11;  // movupd m, xmm
+        constexpr U8 PdUnpckl = 0x14;
+        constexpr U8 PdMove   = 0x28;  // movapd xmm, xmm/m
+        constexpr U8 PdSave   = 0x29;  // movapd m, xmm
+        constexpr U8 PdSqrt   = 0x51;
+        constexpr U8 PdAnd    = 0x54;
+        constexpr U8 PdAndN   = 0x55;
+        constexpr U8 PdOr     = 0x56;
+        constexpr U8 PdXor    = 0x57;
+        constexpr U8 PdAdd    = 0x58;
+        constexpr U8 PdMul    = 0x59;
+        constexpr U8 PdSub    = 0x5C;
+        constexpr U8 PdDiv    = 0x5E;
+        constexpr U8 PdCmp    = 0xC2;
+
+        constexpr U64 SignBit = 0x8000000000000000ull;
+
+        U64 bits(const R64 v)
+        {
+            U64 r;
+            memcpy(&r, &v, sizeof(R64));
+            return r;
+        }
+
+        Native::Operand xmm(const U8 nr)
+        {
+            return {KindXmm, nr};
+        }
+
+        // The number of registers op reads, starting at its dst.
+        U8 operands(const OpCode op)
+        {
+            switch (op)
+            {
+            case OpNone:
+            case OpConst:
+            case OpLoad:
+            case OpAssign:
+            case OpGroup:
+                return 0;
+            case OpMove:  // reads dst + 1 only
+            case OpAdd:
+            case OpSub:
+            case OpMul:
+            case OpDiv:
+            case OpPow:
+            case OpMod:
+            case OpAtan2:
+            case OpFmod:
+                return 2;
+            default:
+                return 1;
+            }
+        }
+
+    }  // namespace
+
+    Native::~Native()
+    {
+        release();
+    }
+
+    bool Native::supported()
+    {
+        return JAM_EQ_NATIVE != 0;
+    }
+
+    void Native::clear()
+    {
+        _function = nullptr;
+        _code.clear();
+        _fixups.clear();
+        _constants.clear();
+    }
+
+    void Native::emit(const U8* bytes, const size_t nr)
+    {
+        for (size_t i = 0; i < nr; ++i)
+            _code.push_back(bytes[i]);
+    }
+
+    void Native::emit(const std::initializer_list<U8> bytes)
+    {
+        emit(bytes.begin(), bytes.size());
+    }
+
+    void Native::emit32(const I32 value)
+    {
+        U8 bytes[4];
+        memcpy(bytes, &value, 4);
+        emit(bytes, 4);
+    }
+
+    void Native::sse(const U8       prefix,
+                     const U8       op,
+                     const U8       reg,
+                     const Operand& rm,
+                     const I32      imm)
+    {
+        U8 rex   = reg >= 8 ? 0x04 : 0x00;
+        U8 modrm = U8((reg & 7) << 3);
+
+        // clang-format off
+        switch (rm.kind) {
+        case KindXmm      : modrm |= 0xC0 | (rm.value & 7); rex |= rm.value >= 8 ? 1 : 0; break;
+        case KindSpill    : modrm |= 0x83; break;
+        case KindVariable : modrm |= 0x85; break;
+        case KindConstant : modrm |= 0x05; break;
+        case KindSample   : modrm |= 0x04; rex |= 1; break;
+        case KindResult   : modrm |= 0x45; rex |= 1; break;
+        default: break;
+        }
+        // clang-format on
+
+        emit({prefix});
+        if (rex)
+            emit({U8(0x40 | rex)});
+        emit({0x0F, op, modrm});
+
+        switch (rm.kind)
+        {
+        case KindSpill:
+        case KindVariable:
+            emit32(rm.value);
+            break;
+        case KindConstant:
+            _fixups.push_back({U32(_code.size()), U32(rm.value)});
+            emit32(0);
+            break;
+        case KindSample:
+            emit({0x24});
+            break;
+        case KindResult:
+            emit({0x00});
+            break;
+        default:
+            break;
+        }
+
+        if (imm >= 0)
+            emit({U8(imm)});
+    }
+
+    Native::Operand Native::constant(const U64 lo, const U64 hi)
+    {
+        for (U32 i = 0; i < _constants.size(); ++i)
+        {
+            if (_constants[i].lo == lo && _constants[i].hi == hi)
+                return {KindConstant, I32(i)};
+        }
+        _constants.push_back({lo, hi});
+        return {KindConstant, I32(_constants.size() - 1)};
+    }
+
+    Native::Operand Native::constant(const R64 value)
+    {
+        return constant(bits(value), bits(value));
+    }
+
+    void Native::lifetimes(const Program& prog)
+    {
+        // Every value on the stack is read exactly once. _ends holds, for
+        // each instruction, the index of the one reading its result.
+        const InstructionArray& code = prog.code();
+        const U32               n    = code.size();
+
+        SimpleArray<U32> defined;
+        defined.reserve(_registers + 1);
+        for (U32 i = 0; i <= _registers; ++i)
+            defined.push_back(JtNpos32);
+
+        _ends.clear();
+        _ends.reserve(n);
+        for (U32 i = 0; i < n; ++i)
+            _ends.push_back(n);
+
+        for (U32 i = 0; i < n; ++i)
+        {
+            const Instruction& ins = code[i];
+
+            const U8 nr = operands(OpCode(ins.op));
+            for (U16 r = ins.op == OpMove ? 1 : 0; r < nr; ++r)
+            {
+                if (const U32 def = defined[U32(ins.dst + r)]; def != JtNpos32)
+                    _ends[def] = i;
+                defined[U32(ins.dst + r)] = JtNpos32;
+            }
+            if (ins.op != OpNone)
+                defined[ins.dst] = i;
+        }
+    }
+
+    Native::Operand Native::locate(const U16 reg) const
+    {
+        if (const I8 x = _where[reg]; x >= 0)
+            return xmm(U8(x));
+        return {KindSpill, I32(reg) * 16};
+    }
+
+    void Native::evict(const U8 x)
+    {
+        const I32 reg = _owner[x];
+        sse(0x66, PdSave, x, {KindSpill, reg * 16});
+        _where[U32(reg)] = -1;
+        _owner[x]        = -1;
+    }
+
+    U8 Native::allocate(const U32 until)
+    {
+        I32 victim = -1;
+        for (U8 x = FirstXmm; x < 16; ++x)
+        {
+            if (_owner[x] < 0)
+                return x;
+            if (victim < 0 || _until[U32(_owner[x])] > _until[U32(_owner[victim])])
+                victim = x;
+        }
+
+        // spill the value that is needed last, unless it is this one
+        if (_until[U32(_owner[victim])] > until)
+        {
+            evict(U8(victim));
+            return U8(victim);
+        }
+        return 0;
+    }
+
+    void Native::consume(const U16 reg)
+    {
+        if (const I8 x = _where[reg]; x >= 0)
+            _owner[x] = -1;
+        _where[reg] = -1;
+    }
+
+    void Native::assign(const U16 reg, const U8 x, const U32 until)
+    {
+        // a value that was never read is overwritten
+        if (const I8 old = _where[reg]; old >= 0 && old != I8(x))
+            _owner[old] = -1;
+
+        _until[reg] = until;
+        if (x == 0)
+        {
+            // there was no register for it, so it lives in memory
+            sse(0x66, PdSave, 0, {KindSpill, I32(reg) * 16});
+            _where[reg] = -1;
+        }
+        else
+        {
+            _owner[x]   = reg;
+            _where[reg] = I8(x);
+        }
+    }
+
+    U8 Native::target(const U16 reg, const U32 until)
+    {
+        // in place when the operand is already in a register
+        if (const I8 x = _where[reg]; x >= 0)
+            return U8(x);
+        return allocate(until);
+    }
+
+    void Native::call(const void*    fn,
+                      const U16      dst,
+                      const U32      until,
+                      const Operand* k)
+    {
+        // the operands are read from memory, and nothing
+        // survives the call in a register
+        for (U8 x = FirstXmm; x < 16; ++x)
+        {
+            if (_owner[x] >= 0)
+                evict(x);
+        }
+
+        // lea rdi/rcx, [rbx + disp32]
+#ifdef _WIN32
+        emit({0x48, 0x8D, 0x8B});
+#else
+        emit({0x48, 0x8D, 0xBB});
+#endif
+        emit32(I32(dst) * 16);
+
+        if (k)
+        {
+            // lea rsi/rdx, [rip + disp32]
+#ifdef _WIN32
+            emit({0x48, 0x8D, 0x15});
+#else
+            emit({0x48, 0x8D, 0x35});
+#endif
+            _fixups.push_back({U32(_code.size()), U32(k->value)});
+            emit32(0);
+        }
+
+        // mov rax, imm64; call rax
+        U8 bytes[8];
+        memcpy(bytes, &fn, 8);
+        emit({0x48, 0xB8});
+        emit(bytes, 8);
+        emit({0xFF, 0xD0});
+
+        // the result is returned in xmm0
+        const U8 t = allocate(until);
+        if (t != 0)
+            sse(0x66, PdMove, t, xmm(0));
+        assign(dst, t, until);
+    }
+
+    bool Native::translate(const Instruction& ins, const U32 until)
+    {
+        const U16     d = ins.dst;
+        const Operand a = locate(d);
+        const Operand b = locate(U16(d + 1));
+
+        // Statement::executeImpl: fabs(b) > DBL_EPSILON ? n * (1.0 / b) : NAN
+        const auto divide = [this, d, until](const Operand& n, const Operand& den)
+        {
+            sse(0x66, PdMove, 1, den);
+            sse(0x66, PdAnd, 1, constant(~SignBit, ~SignBit));
+            sse(0x66, PdMove, 0, constant(DBL_EPSILON));
+            sse(0x66, PdCmp, 0, xmm(1), 1);  // eps < |b|
+            sse(0x66, PdMove, 1, constant(1.0));
+            sse(0x66, PdDiv, 1, den);
+            sse(0x66, PdMul, 1, n);
+            sse(0x66, PdAnd, 1, xmm(0));
+            sse(0x66, PdAndN, 0, constant(NAN));
+            sse(0x66, PdOr, 0, xmm(1));
+
+            consume(U16(d + 1));
+            const U8 t = target(d, until);
+            if (t != 0)
+                sse(0x66, PdMove, t, xmm(0));
+            assign(d, t, until);
+        };
+
+        // d = d op rm, then frees d + 1 if it was read
+        const auto inPlace = [this, d, a, until](const U8 op, const Operand& rm, const bool binary)
+        {
+            const U8 t = target(d, until);
+            if (a.kind != KindXmm || a.value != t)
+                sse(0x66, PdMove, t, a);
+            sse(0x66, op, t, rm);
+            if (binary)
+                consume(U16(d + 1));
+            assign(d, t, until);
+        };
+
+        // d = op(d)
+        const auto self = [this, d, a, until](const U8 op)
+        {
+            const U8 t = target(d, until);
+            if (a.kind != KindXmm || a.value != t)
+                sse(0x66, PdMove, t, a);
+            sse(0x66, op, t, xmm(t));
+            assign(d, t, until);
+        };
+
+        // d = value, without reading d
+        const auto define = [this, d, until](const Operand& src)
+        {
+            const U8 t = allocate(until);
+            sse(0x66, src.kind == KindSample ? PdLoad : PdMove, t, src);
+            assign(d, t, until);
+        };
+
+        switch (ins.op)
+        {
+        case OpNone:
+            break;
+        case OpConst:
+            define(constant(ins.value));
+            break;
+        case OpLoad:
+            if (ins.index == _slot)
+                define({KindSample, 0});
+            else
+            {
+                // movsd, then copy the low lane into the high one
+                const U8 t = allocate(until);
+                sse(0xF2, PdLoad, t, {KindVariable, I32(ins.index) * 8});
+                sse(0x66, PdUnpckl, t, xmm(t));
+                assign(d, t, until);
+            }
+            break;
+        case OpMove:
+            if (b.kind == KindXmm)
+            {
+                // just rename the register
+                consume(U16(d + 1));
+                assign(d, U8(b.value), until);
+            }
+            else
+                define(b);
+            break;
+        // clang-format off
+        case OpAdd  : inPlace(PdAdd, b, true);                                 break;
+        case OpSub  : inPlace(PdSub, b, true);                                 break;
+        case OpMul  : inPlace(PdMul, b, true);                                 break;
+        case OpNeg  : inPlace(PdXor, constant(SignBit, SignBit), false);       break;
+        case OpAbs  : inPlace(PdAnd, constant(~SignBit, ~SignBit), false);     break;
+        case OpSqrt : self(PdSqrt);                                            break;
+        case OpSqr  : self(PdMul);                                             break;
+        case OpAddK : inPlace(PdAdd, constant(ins.value), false);              break;
+        case OpSubK : inPlace(PdSub, constant(ins.value), false);              break;
+        case OpMulK : inPlace(PdMul, constant(ins.value), false);              break;
+        // clang-format on
+        case OpRSubK:
+        {
+            sse(0x66, PdMove, 1, constant(ins.value));
+            sse(0x66, PdSub, 1, a);
+            const U8 t = target(d, until);
+            sse(0x66, PdMove, t, xmm(1));
+            assign(d, t, until);
+            break;
+        }
+        case OpDiv:
+            divide(a, b);
+            break;
+        case OpRDivK:
+            divide(constant(ins.value), a);
+            break;
+        case OpPowK:
+        {
+            const Operand k = constant(ins.value);
+            call((const void*)&rowPowK, d, until, &k);
+            break;
+        }
+        // clang-format off
+        case OpPow   : call((const void*)&rowBinary<nPow>, d, until);   break;
+        case OpMod   : call((const void*)&rowBinary<nMod>, d, until);   break;
+        case OpAtan2 : call((const void*)&rowBinary<nAtan2>, d, until); break;
+        case OpFmod  : call((const void*)&rowBinary<nFmod>, d, until);  break;
+        case OpAcos  : call((const void*)&rowUnary<nAcos>, d, until);   break;
+        case OpAsin  : call((const void*)&rowUnary<nAsin>, d, until);   break;
+        case OpAtan  : call((const void*)&rowUnary<nAtan>, d, until);   break;
+        case OpCeil  : call((const void*)&rowUnary<nCeil>, d, until);   break;
+        case OpCos   : call((const void*)&rowUnary<nCos>, d, until);    break;
+        case OpCosh  : call((const void*)&rowUnary<nCosh>, d, until);   break;
+        case OpExp   : call((const void*)&rowUnary<nExp>, d, until);    break;
+        case OpFloor : call((const void*)&rowUnary<nFloor>, d, until);  break;
+        case OpLog   : call((const void*)&rowUnary<nLog>, d, until);    break;
+        case OpLog10 : call((const void*)&rowUnary<nLog10>, d, until);  break;
+        case OpSin   : call((const void*)&rowUnary<nSin>, d, until);    break;
+        case OpSinh  : call((const void*)&rowUnary<nSinh>, d, until);   break;
+        case OpTan   : call((const void*)&rowUnary<nTan>, d, until);    break;
+        case OpTanh  : call((const void*)&rowUnary<nTanh>, d, until);   break;
+        // clang-format on
+        case OpAssign:
+        case OpGroup:
+        default:
+            return false;
+        }
+        return true;
+    }
+
+    void Native::prologue()
+    {
+        // push rbx, rbp, r12, r13, r14
+        emit({0x53, 0x55, 0x41, 0x54, 0x41, 0x55, 0x41, 0x56});
+
+#ifdef _WIN32
+        // mov r14, [rsp + 80], the fifth argument
+        emit({0x4C, 0x8B, 0x74, 0x24, 0x50});
+        // mov rbx, rcx; mov rbp, rdx; mov r12, r8; mov r13, r9
+        emit({0x48, 0x89, 0xCB, 0x48, 0x89, 0xD5, 0x4D, 0x89, 0xC4, 0x4D, 0x89, 0xCD});
+
+        // sub rsp, 192; then save xmm6 to xmm15 above the shadow space
+        emit({0x48, 0x81, 0xEC});
+        emit32(192);
+        for (U8 i = 6; i < 16; ++i)
+        {
+            emit({0x66});
+            if (i >= 8)
+                emit({0x44});
+            emit({0x0F, 0x11, U8(0x84 | (i & 7) << 3), 0x24});
+            emit32(32 + (i - 6) * 16);
+        }
+#else
+        // mov rbx, rdi; mov rbp, rsi; mov r12, rdx; mov r13, rcx; mov r14, r8
+        emit({0x48, 0x89, 0xFB, 0x48, 0x89, 0xF5, 0x49, 0x89, 0xD4, 0x49, 0x89, 0xCD, 0x4D, 0x89, 0xC6});
+#endif
+    }
+
+    void Native::epilogue(const U16 depth)
+    {
+        // store the result of the pair
+        if (depth > 0)
+        {
+            const Operand r = locate(U16(depth - 1));
+            if (r.kind == KindXmm)
+                sse(0x66, PdStore, U8(r.value), {KindResult, 0});
+            else
+            {
+                sse(0x66, PdMove, 0, r);
+                sse(0x66, PdStore, 0, {KindResult, 0});
+            }
+        }
+        else
+        {
+            sse(0x66, PdXor, 0, xmm(0));
+            sse(0x66, PdStore, 0, {KindResult, 0});
+        }
+    }
+
+    bool Native::compile(const Program& prog, const U32 slot)
+    {
+        clear();
+        if (!supported() || prog.empty() || prog.hasSideEffects())
+            return false;
+
+        _slot      = slot;
+        _registers = prog.registers();
+
+        // nothing is in a register when the loop starts
+        _where.clear();
+        _until.clear();
+        for (U32 i = 0; i <= _registers; ++i)
+        {
+            _where.push_back(-1);
+            _until.push_back(0);
+        }
+        for (I32& owner : _owner)
+            owner = -1;
+
+        lifetimes(prog);
+        prologue();
+
+        // test r14, r14; jz done
+        emit({0x4D, 0x85, 0xF6, 0x0F, 0x84});
+        const U32 skip = U32(_code.size());
+        emit32(0);
+
+        const U32 loop = U32(_code.size());
+        for (U32 i = 0; i < prog.code().size(); ++i)
+        {
+            if (!translate(prog.code()[i], _ends[i]))
+            {
+                clear();
+                return false;
+            }
+        }
+        epilogue(prog.depth());
+
+        // add r12, 16; add r13, 16; dec r14; jnz loop
+        emit({0x49, 0x83, 0xC4, 0x10, 0x49, 0x83, 0xC5, 0x10, 0x49, 0xFF, 0xCE, 0x0F, 0x85});
+        emit32(I32(loop) - I32(_code.size() + 4));
+
+        const I32 done = I32(_code.size()) - I32(skip + 4);
+        memcpy(_code.data() + skip, &done, 4);
+
+#ifdef _WIN32
+        for (U8 i = 6; i < 16; ++i)
+        {
+            emit({0x66});
+            if (i >= 8)
+                emit({0x44});
+            emit({0x0F, 0x10, U8(0x84 | (i & 7) << 3), 0x24});
+            emit32(32 + (i - 6) * 16);
+        }
+        emit({0x48, 0x81, 0xC4});
+        emit32(192);
+#endif
+        // pop r14, r13, r12, rbp, rbx; ret
+        emit({0x41, 0x5E, 0x41, 0x5D, 0x41, 0x5C, 0x5D, 0x5B, 0xC3});
+
+        // the constant pool follows the code, 16 byte aligned
+        while (_code.size() % 16)
+            emit({0xCC});
+
+        const U32 pool = U32(_code.size());
+        for (const Constant& c : _constants)
+        {
+            U8 bytes[16];
+            memcpy(bytes, &c.lo, 8);
+            memcpy(bytes + 8, &c.hi, 8);
+            emit(bytes, 16);
+        }
+
+        for (const Fixup& f : _fixups)
+        {
+            const I32 rel = I32(pool + f.index * 16) - I32(f.at + 4);
+            memcpy(_code.data() + f.at, &rel, 4);
+        }
+        return install();
+    }
+
+    void Native::execute(R64*         spill,
+                         const R64*   variables,
+                         const R64*   xs,
+                         R64*         ys,
+                         const size_t n) const
+    {
+        if (const size_t pairs = n / 2; pairs > 0)
+            _function(spill, variables, xs, ys, pairs);
+
+        if (n & 1)
+        {
+            const R64 tx[2] = {xs[n - 1], xs[n - 1]};
+            R64       ty[2];
+            _function(spill, variables, tx, ty, 1);
+            ys[n - 1] = ty[0];
+        }
+    }
+
+#if JAM_EQ_NATIVE
+    #ifdef _WIN32
+
+    bool Native::install()
+    {
+        const size_t size = _code.size();
+        DWORD        old  = 0;
+        if (_capacity < size)
+        {
+            release();
+            _memory = (U8*)VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+            if (!_memory)
+                return false;
+            _capacity = size;
+        }
+        else if (!VirtualProtect(_memory, _capacity, PAGE_READWRITE, &old))
+            return false;
+
+        memcpy(_memory, _code.data(), size);
+        if (!VirtualProtect(_memory, _capacity, PAGE_EXECUTE_READ, &old))
+            return false;
+
+        FlushInstructionCache(GetCurrentProcess(), _memory, size);
+        _function = (Function)_memory;
+        return true;
+    }
+
+    void Native::release()
+    {
+        if (_memory)
+            VirtualFree(_memory, 0, MEM_RELEASE);
+        _memory   = nullptr;
+        _capacity = 0;
+        _function = nullptr;
+    }
+
+    #else
+
+    bool Native::install()
+    {
+        const size_t page = size_t(sysconf(_SC_PAGESIZE));
+        const size_t size = (_code.size() + page - 1) / page * page;
+
+        if (_capacity < size)
+        {
+            release();
+            void* mem = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (mem == MAP_FAILED)
+                return false;
+            _memory   = (U8*)mem;
+            _capacity = size;
+        }
+        else if (mprotect(_memory, _capacity, PROT_READ | PROT_WRITE) != 0)
+            return false;
+
+        memcpy(_memory, _code.data(), _code.size());
+        if (mprotect(_memory, _capacity, PROT_READ | PROT_EXEC) != 0)
+            return false;
+
+        _function = (Function)_memory;
+        return true;
+    }
+
+    void Native::release()
+    {
+        if (_memory)
+            munmap(_memory, _capacity);
+        _memory   = nullptr;
+        _capacity = 0;
+        _function = nullptr;
+    }
+
+    #endif
+#else
+
+    bool Native::install()
+    {
+        return false;
+    }
+
+    void Native::release()
+    {
+        _function = nullptr;
+    }
+
+#endif
+
+}  // namespace Jam::Eq
@@ -0,0 +1,177 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+#include "Equation/Program.h"
+
+#if defined(JAM_EQ_JIT) && (defined(__x86_64__) || defined(_M_X64))
+    #define JAM_EQ_NATIVE 1
+#else
+    #define JAM_EQ_NATIVE 0
+#endif
+
+namespace Jam::Eq
+{
+    using CodeBuffer = SimpleArray<U8>;
+
+    /**
+     * \brief Translates a Program into x86-64 machine code that evaluates
+     * it for a whole array of samples.
+     *
+     * Two samples are evaluated at once with packed SSE2 instructions.
+     * Stack values are given xmm registers; the ones needed last, and
+     * everything live across a call, go to a caller supplied spill area.
+     * Operations that are not a single instruction call the same libm
+     * functions the interpreter uses, so both produce identical results.
+     *
+     * Only programs without side effects are translated. compile returns
+     * false for the others, and on builds without JAM_EQ_JIT or on other
+     * architectures, in which case the interpreter should be used.
+     */
+    class Native
+    {
+    public:
+        using Function = void (*)(R64*       spill,
+                                  const R64* variables,
+                                  const R64* xs,
+                                  R64*       ys,
+                                  size_t     pairs);
+
+        struct Operand
+        {
+            U8  kind{0};
+            I32 value{0};
+        };
+
+        struct Fixup
+        {
+            U32 at{0};
+            U32 index{0};
+        };
+
+        struct Constant
+        {
+            U64 lo{0};
+            U64 hi{0};
+        };
+
+    private:
+        CodeBuffer            _code;
+        SimpleArray<Fixup>    _fixups;
+        SimpleArray<Constant> _constants;
+        SimpleArray<U32>      _ends;
+        SimpleArray<I8>       _where;
+        SimpleArray<U32>      _until;
+        I32                   _owner[16]{};
+        U8*                   _memory{nullptr};
+        size_t                _capacity{0};
+        Function              _function{nullptr};
+        U32                   _slot{JtNpos32};
+        U16                   _registers{0};
+
+        void emit(const U8* bytes, size_t nr);
+
+        void emit(std::initializer_list<U8> bytes);
+
+        void emit32(I32 value);
+
+        void sse(U8 prefix, U8 op, U8 reg, const Operand& rm, I32 imm = -1);
+
+        Operand constant(U64 lo, U64 hi);
+
+        Operand constant(R64 value);
+
+        void lifetimes(const Program& prog);
+
+        Operand locate(U16 reg) const;
+
+        U8 allocate(U32 until);
+
+        void evict(U8 xmm);
+
+        void consume(U16 reg);
+
+        void assign(U16 reg, U8 xmm, U32 until);
+
+        U8 target(U16 reg, U32 until);
+
+        void call(const void* fn, U16 dst, U32 until, const Operand* k = nullptr);
+
+        bool translate(const Instruction& ins, U32 until);
+
+        void prologue();
+
+        void epilogue(U16 depth);
+
+        bool install();
+
+        void release();
+
+    public:
+        Native() = default;
+        ~Native();
+
+        Native(const Native&)            = delete;
+        Native& operator=(const Native&) = delete;
+
+        // True if this build can produce native code.
+        static bool supported();
+
+        /**
+         * \brief Translates prog, with the variable at index slot of
+         * prog.names() read from the sample array instead of the
+         * variable array.
+         */
+        bool compile(const Program& prog, U32 slot);
+
+        void clear();
+
+        /**
+         * \brief Evaluates the compiled program for the n values in xs
+         * and writes the results to ys.
+         *
+         * \param spill Scratch memory, 16 byte aligned, of at least
+         * spillSize() values.
+         * \param variables The values of the program's variables,
+         * indexed like its names().
+         */
+        void execute(R64*       spill,
+                     const R64* variables,
+                     const R64* xs,
+                     R64*       ys,
+                     size_t     n) const;
+
+        size_t spillSize() const;
+
+        bool empty() const;
+    };
+
+    inline size_t Native::spillSize() const
+    {
+        return size_t(_registers) * 2 + 2;
+    }
+
+    inline bool Native::empty() const
+    {
+        return _function == nullptr;
+    }
+
+}  // namespace Jam::Eq
@@ -0,0 +1,559 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Equation/Program.h"
+#include <atomic>
+#include "Equation/StackValue.h"
+
+namespace Jam::Eq
+{
+    struct Operand
+    {
+        U8  flag{StackValue::Value};
+        U32 slot{JtNpos32};
+        R64 value{0};
+        U8  constant{0};
+    };
+
+    using OperandStack = SimpleArray<Operand>;
+
+    // A register of the optimizer, start is the index of
+    // the first instruction that computes it.
+    struct FoldEntry
+    {
+        U32 start{0};
+        U8  constant{0};
+        R64 value{0};
+    };
+
+    using FoldStack = SimpleArray<FoldEntry>;
+
+    std::atomic<U32> ProgramId{0};
+
+    OpCode mathOp(const SymbolType type)
+    {
+        // clang-format off
+        switch (type) {
+        case MathAbs   : return OpAbs;
+        case MathAcos  : return OpAcos;
+        case MathAsin  : return OpAsin;
+        case MathAtan  : return OpAtan;
+        case MathAtan2 : return OpAtan2;
+        case MathCeil  : return OpCeil;
+        case MathCos   : return OpCos;
+        case MathCosh  : return OpCosh;
+        case MathExp   : return OpExp;
+        case MathFabs  : return OpAbs;
+        case MathFloor : return OpFloor;
+        case MathFmod  : return OpFmod;
+        case MathLog   : return OpLog;
+        case MathLog10 : return OpLog10;
+        case MathPow   : return OpPow;
+        case MathSin   : return OpSin;
+        case MathSinh  : return OpSinh;
+        case MathSqrt  : return OpSqrt;
+        case MathTan   : return OpTan;
+        case MathTanh  : return OpTanh;
+        default        : return OpNone;
+        }
+        // clang-format on
+    }
+
+    bool isBinaryMathOp(const OpCode op)
+    {
+        return op == OpAtan2 || op == OpFmod || op == OpPow;
+    }
+
+    bool isBinaryOp(const OpCode op)
+    {
+        return (op >= OpAdd && op <= OpMod) || isBinaryMathOp(op);
+    }
+
+    bool isImmediateOp(const OpCode op)
+    {
+        return op >= OpAddK && op <= OpPowK;
+    }
+
+    bool isUnaryOp(const OpCode op)
+    {
+        return (op >= OpNeg && op <= OpTanh && !isBinaryMathOp(op)) ||
+               op == OpSqr;
+    }
+
+    // Returns the form of op with a constant right hand side.
+    OpCode reduceRight(const OpCode op, const R64 k, R64& value)
+    {
+        value = k;
+
+        // clang-format off
+        switch (op) {
+        case OpAdd: return OpAddK;
+        case OpSub: return OpSubK;
+        case OpMul: return OpMulK;
+        case OpDiv:
+            value = fabs(k) > DBL_EPSILON ? 1.0 / k : NAN;
+            return OpMulK;
+        case OpPow:
+            if (k == 2.0) return OpSqr;
+            if (k == 1.0) return OpMove;
+            return OpPowK;
+        default: return OpNone;
+        }
+        // clang-format on
+    }
+
+    // Returns the form of op with a constant left hand side.
+    OpCode reduceLeft(const OpCode op)
+    {
+        // clang-format off
+        switch (op) {
+        case OpAdd: return OpAddK;
+        case OpSub: return OpRSubK;
+        case OpMul: return OpMulK;
+        case OpDiv: return OpRDivK;
+        default   : return OpNone;
+        }
+        // clang-format on
+    }
+
+    R64 lMod(const R64 a, const R64 b)
+    {
+        const R64 r = remainder(a, b);
+        return r < 0 ? b + r : r;
+    }
+
+    R64 Program::evaluate(const OpCode op, const R64 a, const R64 b)
+    {
+        // clang-format off
+        switch (op) {
+        case OpAdd   :
+        case OpAddK  : return a + b;
+        case OpSub   :
+        case OpSubK  : return a - b;
+        case OpRSubK : return b - a;
+        case OpMul   :
+        case OpMulK  : return a * b;
+        case OpDiv   : return fabs(b) > DBL_EPSILON ? a * (1.0 / b) : NAN;
+        case OpRDivK : return fabs(a) > DBL_EPSILON ? b * (1.0 / a) : NAN;
+        case OpPow   :
+        case OpPowK  : return ::pow(a, b);
+        case OpMod   : return fmod(a, b);
+        case OpNeg   : return -a;
+        case OpSqr   : return a * a;
+        case OpAbs   : return fabs(a);
+        case OpAcos  : return acos(a);
+        case OpAsin  : return asin(a);
+        case OpAtan  : return atan(a);
+        case OpAtan2 : return atan2(a, b);
+        case OpCeil  : return ceil(a);
+        case OpCos   : return cos(a);
+        case OpCosh  : return cosh(a);
+        case OpExp   : return exp(a);
+        case OpFloor : return floor(a);
+        case OpFmod  : return lMod(a, b);
+        case OpLog   : return log(a);
+        case OpLog10 : return log10(a);
+        case OpSin   : return sin(a);
+        case OpSinh  : return sinh(a);
+        case OpSqrt  : return sqrt(a);
+        case OpTan   : return tan(a);
+        case OpTanh  : return tanh(a);
+        default      : return 0;
+        }
+        // clang-format on
+    }
+
+    const char* operationName(const SymbolType type)
+    {
+        // clang-format off
+        switch (type) {
+        case Add : return "add";
+        case Sub : return "sub";
+        case Mul : return "mul";
+        case Div : return "div";
+        case Pow : return "pow";
+        case Mod : return "mod";
+        case Neg : return "neg";
+        default  : return "";
+        }
+        // clang-format on
+    }
+
+    OpCode binaryOp(const SymbolType type)
+    {
+        // clang-format off
+        switch (type) {
+        case Add : return OpAdd;
+        case Sub : return OpSub;
+        case Mul : return OpMul;
+        case Div : return OpDiv;
+        case Pow : return OpPow;
+        case Mod : return OpMod;
+        default  : return OpNone;
+        }
+        // clang-format on
+    }
+
+    void Program::clear()
+    {
+        _code.resizeFast(0);
+        _names.clear();
+        _registers   = 0;
+        _depth       = 0;
+        _sideEffects = false;
+        _id          = 0;
+        _error.clear();
+    }
+
+    U32 Program::slot(const String& name)
+    {
+        U32 idx = indexOf(name);
+        if (idx == JtNpos32)
+        {
+            idx = U32(_names.size());
+            _names.push_back(name);
+        }
+        return idx;
+    }
+
+    U32 Program::indexOf(const String& name) const
+    {
+        for (size_t i = 0; i < _names.size(); ++i)
+        {
+            if (_names[i] == name)
+                return U32(i);
+        }
+        return JtNpos32;
+    }
+
+    void Program::emit(const OpCode op,
+                       const U16    dst,
+                       const U32    index,
+                       const R64    value)
+    {
+        _code.push_back({U8(op), 0, dst, index, value});
+    }
+
+    void Program::compile(const SymbolArray& symbols)
+    {
+        if (!tryCompile(symbols))
+            throw Exception(_error);
+    }
+
+    bool Program::tryCompile(const SymbolArray& symbols)
+    {
+        clear();
+        _id = ++ProgramId;
+
+        OperandStack stack;
+        stack.reserve(symbols.size());
+
+        U32 groups = 0;
+
+        for (const Symbol* sy : symbols)
+        {
+            const U16 top = U16(stack.size());
+            if (stack.size() >= 0xFFFF)
+                return fail("maximum stack depth exceeded");
+
+            switch (const SymbolType type = sy->type())
+            {
+            case Numerical:
+            case MathPi:
+            case MathE:
+            {
+                R64 v = sy->value();
+                if (type == MathPi)
+                    v = Pi64;
+                else if (type == MathE)
+                    v = E64;
+
+                emit(OpConst, top, 0, v);
+                stack.push_back({StackValue::Value, JtNpos32, v, 1});
+                break;
+            }
+            case Identifier:
+            {
+                const U32 idx = slot(sy->name());
+                emit(OpLoad, top, idx);
+                stack.push_back({StackValue::Id, idx});
+                break;
+            }
+            case Add:
+            case Sub:
+            case Mul:
+            case Div:
+            case Pow:
+            case Mod:
+                if (top < 2)
+                    return fail("not enough arguments supplied to the '",
+                                operationName(type),
+                                "' operation ");
+                emit(binaryOp(type), top - 2);
+                stack.resizeFast(top - 1);
+                stack.back() = {};
+                break;
+            case Neg:
+                if (top < 1)
+                    return fail("not enough arguments supplied to the '",
+                                operationName(type),
+                                "' operation ");
+                emit(OpNeg, top - 1);
+                stack.back() = {};
+                break;
+            case Assignment:
+            {
+                if (top < 2)
+                    return fail("not enough arguments supplied to the 'assign' operation ");
+
+                const Operand& a = stack.at(top - 2);
+                const Operand& b = stack.at(top - 1);
+
+                const U8 flag = b.flag == StackValue::List
+                                    ? StackValue::List
+                                    : StackValue::Value;
+                if (a.flag == StackValue::Id)
+                {
+                    emit(OpAssign, top - 2, a.slot);
+                    _sideEffects = true;
+                }
+                else
+                    emit(OpMove, top - 2);
+
+                stack.resizeFast(top - 1);
+                stack.back() = {flag};
+                break;
+            }
+            case Grouping:
+            {
+                if (top < 2)
+                    return fail("not enough arguments supplied to the 'group' operation ");
+                if (!stack.back().constant)
+                    return fail("expected a constant element count for the group");
+
+                // the count is folded into the instruction
+                const U8 nr = U8(stack.back().value);
+                _code.pop_back();
+                stack.pop_back();
+
+                if (const U16 depth = top - 1;
+                    depth > nr && nr > 0)
+                {
+                    // list handles carry the index in GroupIndexBits
+                    if (++groups >= 1u << GroupIndexBits)
+                        return fail("too many groups in one statement");
+
+                    emit(OpGroup, depth - nr, nr);
+                    _sideEffects = true;
+                    stack.resizeFast(depth - nr + 1);
+                    stack.back() = {StackValue::List};
+                }
+                break;
+            }
+            case MathAbs:
+            case MathAcos:
+            case MathAsin:
+            case MathAtan:
+            case MathAtan2:
+            case MathCeil:
+            case MathCos:
+            case MathCosh:
+            case MathExp:
+            case MathFabs:
+            case MathFloor:
+            case MathFmod:
+            case MathLog:
+            case MathLog10:
+            case MathPow:
+            case MathSin:
+            case MathSinh:
+            case MathSqrt:
+            case MathTan:
+            case MathTanh:
+            {
+                const OpCode op = mathOp(type);
+                const U16    nr = isBinaryMathOp(op) ? 2 : 1;
+                if (top < nr + 1)
+                    return fail("supplied math function requires at least ",
+                                nr + 1,
+                                " elements on the stack.");
+
+                if (!stack.back().constant || I32(stack.back().value) != nr)
+                    return fail("expected ",
+                                nr,
+                                " argument(s) to the supplied math function");
+
+                _code.pop_back();
+                const U16 depth = top - 1;
+
+                emit(op, depth - nr);
+                stack.resizeFast(depth - nr + 1);
+                stack.back() = {};
+                break;
+            }
+            case UserFunction:
+            case None:
+            case Not:
+            case BitwiseNot:
+            default:
+                break;
+            }
+
+            _registers = Max<U16>(_registers, U16(stack.size()));
+        }
+
+        _depth = U16(stack.size());
+
+        const InstructionArray src = _code;
+        optimize(src, JtNpos32, nullptr);
+        return true;
+    }
+
+    void Program::specialize(const Program& src,
+                             const U32      varying,
+                             const R64*     values)
+    {
+        if (&src == this)
+            return;
+
+        _names       = src._names;
+        _sideEffects = src._sideEffects;
+        _id          = src._id;
+
+        // assignments can change a variable part way through
+        optimize(src._code, varying, src._sideEffects ? nullptr : values);
+    }
+
+    void Program::optimize(const InstructionArray& src,
+                           const U32               varying,
+                           const R64*              values)
+    {
+        FoldStack stack;
+        stack.reserve(src.size());
+
+        _code.resizeFast(0);
+        _registers = 0;
+
+        const auto pushConst = [&](const R64 v)
+        {
+            const U16 dst = U16(stack.size());
+            stack.push_back({_code.size(), 1, v});
+            emit(OpConst, dst, 0, v);
+        };
+
+        for (const Instruction& ins : src)
+        {
+            const OpCode op  = (OpCode)ins.op;
+            const U32    top = stack.size();
+
+            if (op == OpConst)
+                pushConst(ins.value);
+            else if (op == OpLoad)
+            {
+                if (values && ins.index != varying)
+                    pushConst(values[ins.index]);
+                else
+                {
+                    stack.push_back({_code.size()});
+                    emit(OpLoad, U16(top), ins.index);
+                }
+            }
+            else if (isUnaryOp(op) || isImmediateOp(op))
+            {
+                const FoldEntry a = stack.back();
+                if (a.constant)
+                {
+                    _code.pop_back();
+                    stack.pop_back();
+                    pushConst(evaluate(op, a.value, ins.value));
+                }
+                else
+                    emit(op, U16(top - 1), 0, ins.value);
+            }
+            else if (isBinaryOp(op))
+            {
+                const FoldEntry a   = stack.at(top - 2);
+                const FoldEntry b   = stack.at(top - 1);
+                const U16       dst = U16(top - 2);
+
+                stack.resizeFast(top - 2);
+                if (a.constant && b.constant)
+                {
+                    _code.resizeFast(a.start);
+                    pushConst(evaluate(op, a.value, b.value));
+                    continue;
+                }
+
+                R64    k = 0;
+                OpCode r = OpNone;
+                if (b.constant)
+                {
+                    r = reduceRight(op, b.value, k);
+                    if (r != OpNone)
+                        _code.pop_back();
+                }
+                else if (a.constant)
+                {
+                    r = reduceLeft(op);
+                    k = a.value;
+                    if (r != OpNone)
+                    {
+                        // drop the constant and move the right
+                        // hand side down into its register
+                        for (U32 i = a.start; i + 1 < _code.size(); ++i)
+                        {
+                            _code[i] = _code[i + 1];
+                            _code[i].dst--;
+                        }
+                        _code.pop_back();
+                    }
+                }
+
+                if (r == OpNone)
+                    emit(op, dst);
+                else if (r != OpMove)
+                    emit(r, dst, 0, k);
+                stack.push_back({a.start});
+            }
+            else if (op == OpMove || op == OpAssign)
+            {
+                const U32 start = stack.at(top - 2).start;
+                stack.resizeFast(top - 2);
+                stack.push_back({start});
+                emit(op, U16(top - 2), ins.index);
+            }
+            else if (op == OpGroup)
+            {
+                const U32 dst   = top - ins.index;
+                const U32 start = stack.at(dst).start;
+                stack.resizeFast(dst);
+                stack.push_back({start});
+                emit(op, U16(dst), ins.index);
+            }
+
+            _registers = Max<U16>(_registers, U16(top));
+            _registers = Max<U16>(_registers, U16(stack.size()));
+        }
+
+        _depth = U16(stack.size());
+    }
+
+}  // namespace Jam::Eq
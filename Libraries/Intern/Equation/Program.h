@@ -0,0 +1,239 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+#include "Equation/StmtParser.h"
+
+namespace Jam::Eq
+{
+    enum OpCode
+    {
+        OpNone,
+        OpConst,
+        OpLoad,
+        OpMove,
+        OpAssign,
+        OpGroup,
+        OpAdd,
+        OpSub,
+        OpMul,
+        OpDiv,
+        OpPow,
+        OpMod,
+        OpNeg,
+
+        // math
+        OpAbs,
+        OpAcos,
+        OpAsin,
+        OpAtan,
+        OpAtan2,
+        OpCeil,
+        OpCos,
+        OpCosh,
+        OpExp,
+        OpFloor,
+        OpFmod,
+        OpLog,
+        OpLog10,
+        OpSin,
+        OpSinh,
+        OpSqrt,
+        OpTan,
+        OpTanh,
+
+        // reduced forms, the immediate operand is stored in value
+        OpSqr,
+        OpAddK,
+        OpSubK,
+        OpRSubK,
+        OpMulK,
+        OpRDivK,
+        OpPowK,
+    };
+
+    /**
+     * \brief A single register instruction.
+     *
+     * Operands are addressed relative to dst, so a binary operation
+     * reads dst and dst + 1 and writes the result back into dst.
+     */
+    struct Instruction
+    {
+        U8  op{OpNone};
+        U8  pad{0};
+        U16 dst{0};
+        U32 index{0};
+        R64 value{0};
+    };
+
+    using InstructionArray = SimpleArray<Instruction>;
+
+    // Floored modulo used by fmod.
+    R64 lMod(R64 a, R64 b);
+
+    /**
+     * \brief Lowers the postfix SymbolArray that StmtParser produces
+     * into a flat, pointer free instruction stream.
+     *
+     * The stack depth of every postfix symbol is known at compile time,
+     * so each stack position is mapped onto a register index and stack
+     * underflow is reported here instead of during evaluation.
+     * Identifiers are resolved to indices into names().
+     *
+     * Compiling also folds constant subtrees, moves constant operands
+     * into immediate forms and reduces pow by 2 and 1 to a multiply
+     * and a move. pow by 0.5 is left alone, since sqrt differs from it
+     * at -0 and -inf.
+     */
+    class Program
+    {
+    private:
+        InstructionArray _code;
+        StringArray      _names;
+        U16              _registers{0};
+        U16              _depth{0};
+        bool             _sideEffects{false};
+        U32              _id{0};
+        String           _error;
+
+        U32 slot(const String& name);
+
+        void emit(OpCode op, U16 dst, U32 index = 0, R64 value = 0);
+
+        void optimize(const InstructionArray& src,
+                      U32                     varying,
+                      const R64*              values);
+
+        template <typename... Args>
+        bool fail(Args&&... args);
+
+    public:
+        Program() = default;
+
+        // Compiles symbols and throws an Exception with error() on failure.
+        void compile(const SymbolArray& symbols);
+
+        /**
+         * \brief Compiles symbols without throwing.
+         *
+         * On failure the program is left empty, so it evaluates to zero,
+         * and error() holds the first problem found. Every check is done
+         * here, so evaluating a compiled program never throws.
+         */
+        bool tryCompile(const SymbolArray& symbols);
+
+        /**
+         * \brief Makes a copy of src where every variable other than the
+         * one at index varying is replaced by its value in values, and
+         * folds what becomes constant.
+         *
+         * values is indexed like src.names(). The copy keeps the names and
+         * the id of src, so it binds to the same slots. Programs with side
+         * effects are copied unchanged.
+         */
+        void specialize(const Program& src, U32 varying, const R64* values);
+
+        // Applies op to a and b the same way the interpreter does.
+        static R64 evaluate(OpCode op, R64 a, R64 b);
+
+        void clear();
+
+        U32 indexOf(const String& name) const;
+
+        const InstructionArray& code() const;
+
+        const StringArray& names() const;
+
+        U16 registers() const;
+
+        U16 depth() const;
+
+        // True if the program assigns variables or creates groups.
+        bool hasSideEffects() const;
+
+        // Unique for every call to compile, zero if never compiled.
+        U32 id() const;
+
+        bool empty() const;
+
+        // The first error of the last compile, empty if it succeeded.
+        const String& error() const;
+
+        bool valid() const;
+    };
+
+    inline const InstructionArray& Program::code() const
+    {
+        return _code;
+    }
+
+    inline const StringArray& Program::names() const
+    {
+        return _names;
+    }
+
+    inline U16 Program::registers() const
+    {
+        return _registers;
+    }
+
+    inline U16 Program::depth() const
+    {
+        return _depth;
+    }
+
+    inline bool Program::hasSideEffects() const
+    {
+        return _sideEffects;
+    }
+
+    inline U32 Program::id() const
+    {
+        return _id;
+    }
+
+    inline bool Program::empty() const
+    {
+        return _code.empty();
+    }
+
+    inline const String& Program::error() const
+    {
+        return _error;
+    }
+
+    inline bool Program::valid() const
+    {
+        return _error.empty();
+    }
+
+    template <typename... Args>
+    bool Program::fail(Args&&... args)
+    {
+        OutputStringStream stream;
+        ((stream << std::forward<Args>(args)), ...);
+        clear();
+        _error = stream.str();
+        return false;
+    }
+
+}  // namespace Jam::Eq
@@ -37,6 +37,10 @@ namespace Jam::Eq
 {
     constexpr U32 InitialHash = 0x3E5;
 
+    // A list value is the handle InitialHash + index, with the
+    // generation of the list storage above the index bits.
+    constexpr U32 GroupIndexBits = 20;
+
     struct StackValue
     {
         enum Flags
@@ -62,8 +66,6 @@ namespace Jam::Eq
 
     using EvalStack     = Stack<StackValue, AOP_SIMPLE_TYPE>;
     using EvalHash      = HashTable<String, StackValue>;
-    using ValueGrouping = SimpleArray<StackValue>;
-    using EvalGroupHash = HashTable<U32, ValueGrouping*>;
     using ValueList     = SimpleArray<R64>;
 
     inline bool StackValue::isList() const
@@ -1,337 +1,548 @@
 #include "Statement.h"
-#include "Utils/StreamMethods.h"
 
 namespace Jam::Eq
 {
 
-    OStream& operator<<(OStream& out, const StackValue& v)
+    void Statement::bind(const Program& prog)
     {
-        out << "{ ";
-        out << "c:" << Hex(v.c);
-        out << ", ";
-        out << "f:" << Hex(v.f);
-        out << ", ";
-        out << "v:" << SetD({v.v}, sizeof(double) << 1, 14);
-        out << " }";
-        return out;
-    }
-
-    void trace(EvalStack&    stack,
-               const String& message,
-               const bool    topToBottom = true)
-    {
-        const int iOffs = stack.sizeI();
+        if (_bound == prog.id())
+            return;
+        _bound = prog.id();
 
-        Dbg::println(Tab(4), message);
+        const StringArray& names = prog.names();
 
-        for (int i = 0; i < iOffs; ++i)
+        _slots.resizeFast(SlotArray::SizeType(names.size()));
+        for (size_t i = 0; i < names.size(); ++i)
         {
-            int c = iOffs - i - 1;
-            if (!topToBottom)
-                c = i;
-            Dbg::println(Tab(4), SetI({i}), ':', ' ', stack[c]);
+            size_t idx = _variables.find(names[i]);
+            if (idx == JtNpos)
+            {
+                _variables.insert(names[i], {0});
+                idx = _variables.find(names[i]);
+            }
+            _slots[SlotArray::SizeType(i)] = idx;
         }
     }
 
-    void Statement::push(const R64& v, const size_t& idx, const U8 flag)
-    {
-        _stack.push({v, idx, flag});
-    }
-
-    void Statement::push(const Symbol* sy)
-    {
-        push(sy->value());
-    }
-
-    void Statement::store(const Symbol* sym)
+    void Statement::group(R64* dst, const U32 nr)
     {
-        size_t idx = _variables.find(sym->name());
-        if (idx == JtNpos)
+        // The first list of an execution recycles the storage of the
+        // previous one, so repeated evaluation does not grow it.
+        if (_groupExecution != _execution)
         {
-            _variables.insert(sym->name(), {sym->value()});
-            idx = _variables.find(sym->name());
+            if (_groupExecution != 0)
+                ++_generation;
+
+            _groupExecution = _execution;
+            _groupValues.resizeFast(0);
+            _groups.resizeFast(0);
         }
-        push(_variables.at(idx).v, idx, StackValue::Id);
+
+        // Program::tryCompile limits the number of groups,
+        // so the index always fits into GroupIndexBits.
+        const U32 index = U32(_groups.size());
+        _groups.push_back({U32(_groupValues.size()), nr});
+        for (U32 i = 0; i < nr; ++i)
+            _groupValues.push_back(dst[i]);
+
+        dst[0] = R64(InitialHash) + R64((U64(_generation) << GroupIndexBits) + index);
     }
 
-    void Statement::add()
+    R64 Statement::executeImpl(const Program& prog)
     {
-        if (_stack.size() > 1)
+        bind(prog);
+        ++_execution;
+
+        _depth = 0;
+        _registers.resizeFast(prog.registers());
+
+        R64* const          r = _registers.data();
+        const size_t* const s = _slots.data();
+
+        for (const Instruction& ins : prog.code())
         {
-            const R64& b = _stack.popTop().v;
-            const R64& a = _stack.popTop().v;
-            push(a + b);
+            R64* d = r + ins.dst;
+
+            // clang-format off
+            switch (ins.op) {
+            case OpConst : d[0] = ins.value;                      break;
+            case OpLoad  : d[0] = _variables[s[ins.index]].v;     break;
+            case OpMove  : d[0] = d[1];                           break;
+            case OpAssign:
+                d[0] = d[1];
+                _variables[s[ins.index]] = {d[1]};
+                break;
+            case OpGroup : group(d, ins.index);                   break;
+            case OpAdd   : d[0] = d[0] + d[1];                    break;
+            case OpSub   : d[0] = d[0] - d[1];                    break;
+            case OpMul   : d[0] = d[0] * d[1];                    break;
+            case OpDiv   :
+                d[0] = fabs(d[1]) > DBL_EPSILON ? d[0] * (1.0 / d[1]) : NAN;
+                break;
+            case OpPow   : d[0] = ::pow(d[0], d[1]);              break;
+            case OpMod   : d[0] = fmod(d[0], d[1]);               break;
+            case OpNeg   : d[0] = -d[0];                          break;
+            case OpAbs   : d[0] = fabs(d[0]);                     break;
+            case OpAcos  : d[0] = acos(d[0]);                     break;
+            case OpAsin  : d[0] = asin(d[0]);                     break;
+            case OpAtan  : d[0] = atan(d[0]);                     break;
+            case OpAtan2 : d[0] = atan2(d[0], d[1]);              break;
+            case OpCeil  : d[0] = ceil(d[0]);                     break;
+            case OpCos   : d[0] = cos(d[0]);                      break;
+            case OpCosh  : d[0] = cosh(d[0]);                     break;
+            case OpExp   : d[0] = exp(d[0]);                      break;
+            case OpFloor : d[0] = floor(d[0]);                    break;
+            case OpFmod  : d[0] = lMod(d[0], d[1]);               break;
+            case OpLog   : d[0] = log(d[0]);                      break;
+            case OpLog10 : d[0] = log10(d[0]);                    break;
+            case OpSin   : d[0] = sin(d[0]);                      break;
+            case OpSinh  : d[0] = sinh(d[0]);                     break;
+            case OpSqrt  : d[0] = sqrt(d[0]);                     break;
+            case OpTan   : d[0] = tan(d[0]);                      break;
+            case OpTanh  : d[0] = tanh(d[0]);                     break;
+            case OpSqr   : d[0] = d[0] * d[0];                    break;
+            case OpAddK  : d[0] = d[0] + ins.value;               break;
+            case OpSubK  : d[0] = d[0] - ins.value;               break;
+            case OpRSubK : d[0] = ins.value - d[0];               break;
+            case OpMulK  : d[0] = d[0] * ins.value;               break;
+            case OpRDivK :
+                d[0] = fabs(d[0]) > DBL_EPSILON ? ins.value * (1.0 / d[0]) : NAN;
+                break;
+            case OpPowK  : d[0] = ::pow(d[0], ins.value);         break;
+            case OpNone  :
+            default:
+                break;
+            }
+            // clang-format on
         }
-        else
-            argError("add");
+
+        _depth = prog.depth();
+        return _depth > 0 ? r[_depth - 1] : 0;
     }
 
-    void Statement::sub()
+    R64 Statement::execute(const SymbolArray& val)
     {
-        if (_stack.size() > 1)
+        if (!_scratch.tryCompile(val))
         {
-            const R64& b = _stack.popTop().v;
-            const R64& a = _stack.popTop().v;
-            push(a - b);
+            _depth = 0;
+            return 0;
         }
-        else
-            argError("sub");
+        return executeImpl(_scratch);
     }
 
-    void Statement::neg()
+    R64 Statement::execute(const Program& prog)
     {
-        if (_stack.isNotEmpty())
-        {
-            const R64& a = _stack.popTop().v;
-            push(-a);
-        }
-        else
-            argError("neg");
+        return executeImpl(prog);
     }
 
-    void Statement::mul()
+    template <typename Fn>
+    void lanes(R64* d, const U32 n, Fn fn)
     {
-        if (_stack.size() > 1)
-        {
-            const R64& b = _stack.popTop().v;
-            const R64& a = _stack.popTop().v;
-            push(a * b);
-        }
-        else
-            argError("mul");
+        for (U32 i = 0; i < n; ++i)
+            d[i] = fn(d[i]);
     }
 
-    void Statement::div()
+    template <typename Fn>
+    void lanes(R64* d, const R64* e, const U32 n, Fn fn)
     {
-        if (_stack.size() > 1)
-        {
-            R64        b = _stack.popTop().v;
-            const R64& a = _stack.popTop().v;
-            if (abs(b) > DBL_EPSILON)
-                b = 1.0 / b;
-            else
-                b = NAN;
-
-            push(a * b);
-        }
-        else
-            argError("div");
+        for (U32 i = 0; i < n; ++i)
+            d[i] = fn(d[i], e[i]);
     }
 
-    void Statement::mod()
+    void Statement::executeBlock(const Program& prog,
+                                 const size_t   slot,
+                                 const R64*     xs,
+                                 R64*           ys,
+                                 const U32      n)
     {
-        if (_stack.size() > 1)
+        // Registers are stored as rows of BatchWidth lanes
+        // so that every operation is a flat loop over one row.
+        R64* const          r = _lanes.data();
+        const size_t* const s = _slots.data();
+
+        for (const Instruction& ins : prog.code())
         {
-            const R64& b = _stack.popTop().v;
-            const R64& a = _stack.popTop().v;
-            push(R64(fmod(a, b)));
+            R64* const       d = r + size_t(ins.dst) * BatchWidth;
+            const R64* const e = d + BatchWidth;
+
+            // clang-format off
+            switch (ins.op) {
+            case OpConst : lanes(d, n, [&](R64) { return ins.value; }); break;
+            case OpLoad  :
+                if (s[ins.index] == slot)
+                    memcpy(d, xs, sizeof(R64) * n);
+                else
+                {
+                    const R64 v = _variables[s[ins.index]].v;
+                    lanes(d, n, [v](R64) { return v; });
+                }
+                break;
+            case OpMove  : memcpy(d, e, sizeof(R64) * n);                                   break;
+            case OpAdd   : lanes(d, e, n, [](const R64 a, const R64 b) { return a + b; });  break;
+            case OpSub   : lanes(d, e, n, [](const R64 a, const R64 b) { return a - b; });  break;
+            case OpMul   : lanes(d, e, n, [](const R64 a, const R64 b) { return a * b; });  break;
+            case OpDiv   :
+                lanes(d, e, n, [](const R64 a, const R64 b) {
+                    return fabs(b) > DBL_EPSILON ? a * (1.0 / b) : NAN;
+                });
+                break;
+            case OpPow   : lanes(d, e, n, [](const R64 a, const R64 b) { return ::pow(a, b); });   break;
+            case OpMod   : lanes(d, e, n, [](const R64 a, const R64 b) { return fmod(a, b); });    break;
+            case OpAtan2 : lanes(d, e, n, [](const R64 a, const R64 b) { return atan2(a, b); });   break;
+            case OpFmod  : lanes(d, e, n, [](const R64 a, const R64 b) { return lMod(a, b); });    break;
+            case OpNeg   : lanes(d, n, [](const R64 a) { return -a; });        break;
+            case OpAbs   : lanes(d, n, [](const R64 a) { return fabs(a); });   break;
+            case OpAcos  : lanes(d, n, [](const R64 a) { return acos(a); });   break;
+            case OpAsin  : lanes(d, n, [](const R64 a) { return asin(a); });   break;
+            case OpAtan  : lanes(d, n, [](const R64 a) { return atan(a); });   break;
+            case OpCeil  : lanes(d, n, [](const R64 a) { return ceil(a); });   break;
+            case OpCos   : lanes(d, n, [](const R64 a) { return cos(a); });    break;
+            case OpCosh  : lanes(d, n, [](const R64 a) { return cosh(a); });   break;
+            case OpExp   : lanes(d, n, [](const R64 a) { return exp(a); });    break;
+            case OpFloor : lanes(d, n, [](const R64 a) { return floor(a); });  break;
+            case OpLog   : lanes(d, n, [](const R64 a) { return log(a); });    break;
+            case OpLog10 : lanes(d, n, [](const R64 a) { return log10(a); });  break;
+            case OpSin   : lanes(d, n, [](const R64 a) { return sin(a); });    break;
+            case OpSinh  : lanes(d, n, [](const R64 a) { return sinh(a); });   break;
+            case OpSqrt  : lanes(d, n, [](const R64 a) { return sqrt(a); });   break;
+            case OpTan   : lanes(d, n, [](const R64 a) { return tan(a); });    break;
+            case OpTanh  : lanes(d, n, [](const R64 a) { return tanh(a); });   break;
+            case OpSqr   : lanes(d, n, [](const R64 a) { return a * a; });     break;
+            case OpAddK  : lanes(d, n, [k = ins.value](const R64 a) { return a + k; });  break;
+            case OpSubK  : lanes(d, n, [k = ins.value](const R64 a) { return a - k; });  break;
+            case OpRSubK : lanes(d, n, [k = ins.value](const R64 a) { return k - a; });  break;
+            case OpMulK  : lanes(d, n, [k = ins.value](const R64 a) { return a * k; });  break;
+            case OpRDivK :
+                lanes(d, n, [k = ins.value](const R64 a) {
+                    return fabs(a) > DBL_EPSILON ? k * (1.0 / a) : NAN;
+                });
+                break;
+            case OpPowK  : lanes(d, n, [k = ins.value](const R64 a) { return ::pow(a, k); });   break;
+            case OpAssign:
+            case OpGroup :
+            case OpNone  :
+            default:
+                break;
+            }
+            // clang-format on
         }
+
+        if (const U16 depth = prog.depth(); depth > 0)
+            memcpy(ys, r + size_t(depth - 1) * BatchWidth, sizeof(R64) * n);
         else
-            argError("mod");
+            memset(ys, 0, sizeof(R64) * n);
     }
 
-    void Statement::pow()
+    void Statement::executeBatch(const Program& prog,
+                                 const String&  name,
+                                 const R64*     xs,
+                                 R64*           ys,
+                                 const size_t   n)
     {
-        if (_stack.size() > 1)
-        {
-            const R64& b = _stack.popTop().v;
-            const R64& a = _stack.popTop().v;
-            push(::pow(a, b));
-        }
-        else
-            argError("pow");
+        executeBatch(prog, prog.indexOf(name), xs, ys, n);
     }
 
-    void Statement::group()
+    void Statement::executeBatch(const Program& prog,
+                                 const U32      slot,
+                                 const R64*     xs,
+                                 R64*           ys,
+                                 const size_t   n)
     {
-        if (_stack.size() > 1)
+        if (!xs || !ys || n == 0)
+            return;
+
+        bind(prog);
+
+        if (prog.hasSideEffects())
         {
-            const auto& [v, c, f] = _stack.popTop();
-            if (const U8 nr = U8(v);
-                _stack.size() > nr && nr > 0)
+            // assignments and groups depend on the
+            // evaluation order, so run them one at a time
+            for (size_t i = 0; i < n; ++i)
             {
-                ValueGrouping* vg = new ValueGrouping();
-                for (U8 i = 0; i < nr; ++i)
-                    vg->push_back(_stack.popTop());
+                setSlot(slot, xs[i]);
+                ys[i] = executeImpl(prog);
+            }
+            return;
+        }
 
-                _groups.insert(_hashCount, vg);
+        const size_t   var  = slot < _slots.size() ? _slots[slot] : JtNpos;
+        const Program& code = specialize(prog, slot);
 
-                _stack.push({
-                    R64(_hashCount),
-                    _hashCount,
-                    StackValue::List,
-                });
+        _depth = 0;
 
-                _hashCount++;
-            }
-        }
-        else
-            argError("group");
-    }
+        const bool native = _backend != BackendInterpreter &&
+                            executeNative(code, slot, xs, ys, n);
 
-    void Statement::assign()
-    {
-        if (_stack.size() > 1)
+        if (!native || _backend == BackendCompare)
         {
-            StackValue       c{NAN, JtNpos, 0};
-            const StackValue b = _stack.popTop();
-            const StackValue a = _stack.popTop();
+            _lanes.resizeFast(ValueList::SizeType(code.registers()) * BatchWidth);
 
-            // a = b
-            if (b.isId())
+            R64 block[BatchWidth];
+            for (size_t i = 0; i < n; i += BatchWidth)
             {
-                if (b.c < _variables.size())
+                const U32 m = U32(Min<size_t>(BatchWidth, n - i));
+                executeBlock(code, var, xs + i, native ? block : ys + i, m);
+
+                if (native)
                 {
-                    c.v = _variables[b.c].v;
-                    c.c = b.c;
-                    c.f = StackValue::Id;
+                    for (U32 j = 0; j < m; ++j)
+                    {
+                        if (memcmp(&block[j], &ys[i + j], sizeof(R64)) != 0 &&
+                            !(std::isnan(block[j]) && std::isnan(ys[i + j])))
+                            ++_mismatches;
+                    }
+                    memcpy(ys + i, block, sizeof(R64) * m);
                 }
             }
-            else if (b.isList())
-            {
-                c.v = R64(b.c);
-                c.c = b.c;
-                c.f = StackValue::List;
-            }
-            else
-            {
-                c.v = b.v;
-                c.c = JtNpos;
-                c.f = StackValue::Value;
-            }
-
-            if (a.isId())
-            {
-                if (a.c < _variables.size())
-                    _variables[a.c] = c;
-            }
-
-            _stack.push(c);
         }
-        else
-            argError("assign");
+
+        setSlot(slot, xs[n - 1]);
     }
 
-    void Statement::mathFncA1(WrapFuncA1 f)
+    Interval Statement::executeInterval(const Program&  prog,
+                                        const U32       slot,
+                                        const Interval& x)
     {
-        if (_stack.size() > 1)
+        // assigned variables would have to hold intervals
+        if (prog.hasSideEffects())
+            return ivUnbounded();
+
+        bind(prog);
+        _intervals.resizeFast(prog.registers());
+
+        Interval* const     r = _intervals.data();
+        const size_t* const s = _slots.data();
+
+        for (const Instruction& ins : prog.code())
         {
-            if (_stack.popTop().integer() != 1)
-            {
-                error(
-                    "expected one argument to the "
-                    "supplied math function");
+            Interval* d = r + ins.dst;
+
+            // clang-format off
+            switch (ins.op) {
+            case OpConst : d[0] = ivPoint(ins.value);                          break;
+            case OpLoad  :
+                d[0] = ins.index == slot ? x : ivPoint(_variables[s[ins.index]].v);
+                break;
+            case OpMove  : d[0] = d[1];                                        break;
+            case OpAdd   : d[0] = ivAdd(d[0], d[1]);                           break;
+            case OpSub   : d[0] = ivSub(d[0], d[1]);                           break;
+            case OpMul   : d[0] = ivMul(d[0], d[1]);                           break;
+            case OpDiv   : d[0] = ivDiv(d[0], d[1]);                           break;
+            case OpPow   : d[0] = ivPow(d[0], d[1]);                           break;
+            case OpMod   : d[0] = ivMod(d[0], d[1]);                           break;
+            case OpAtan2 : d[0] = ivAtan2(d[0], d[1]);                         break;
+            case OpFmod  : d[0] = ivFmod(d[0], d[1]);                          break;
+            case OpNeg   : d[0] = ivNeg(d[0]);                                 break;
+            case OpAbs   : d[0] = ivAbs(d[0]);                                 break;
+            case OpAcos  : d[0] = ivAcos(d[0]);                                break;
+            case OpAsin  : d[0] = ivAsin(d[0]);                                break;
+            case OpAtan  : d[0] = ivAtan(d[0]);                                break;
+            case OpCeil  : d[0] = ivCeil(d[0]);                                break;
+            case OpCos   : d[0] = ivCos(d[0]);                                 break;
+            case OpCosh  : d[0] = ivCosh(d[0]);                                break;
+            case OpExp   : d[0] = ivExp(d[0]);                                 break;
+            case OpFloor : d[0] = ivFloor(d[0]);                               break;
+            case OpLog   : d[0] = ivLog(d[0]);                                 break;
+            case OpLog10 : d[0] = ivLog10(d[0]);                               break;
+            case OpSin   : d[0] = ivSin(d[0]);                                 break;
+            case OpSinh  : d[0] = ivSinh(d[0]);                                break;
+            case OpSqrt  : d[0] = ivSqrt(d[0]);                                break;
+            case OpTan   : d[0] = ivTan(d[0]);                                 break;
+            case OpTanh  : d[0] = ivTanh(d[0]);                                break;
+            case OpSqr   : d[0] = ivSqr(d[0]);                                 break;
+            case OpAddK  : d[0] = ivAdd(d[0], ivPoint(ins.value));             break;
+            case OpSubK  : d[0] = ivSub(d[0], ivPoint(ins.value));             break;
+            case OpRSubK : d[0] = ivSub(ivPoint(ins.value), d[0]);             break;
+            case OpMulK  : d[0] = ivMul(d[0], ivPoint(ins.value));             break;
+            case OpRDivK : d[0] = ivDiv(ivPoint(ins.value), d[0]);             break;
+            case OpPowK  : d[0] = ivPow(d[0], ivPoint(ins.value));             break;
+            case OpAssign:
+            case OpGroup :
+            case OpNone  :
+            default:
+                break;
             }
-            const R64& a = _stack.popTop().v;
-            push(f(a));
+            // clang-format on
         }
-        else
-            error(
-                "supplied math function requires "
-                "at least two elements on the stack.");
+
+        const U16 depth = prog.depth();
+        return depth > 0 ? r[depth - 1] : ivPoint(0);
     }
 
-    void Statement::mathFncA2(WrapFuncA2 f)
+    Dual Statement::executeDual(const Program& prog,
+                                const U32      slot,
+                                const R64      x)
     {
-        if (_stack.size() > 2)
+        // assigned variables would have to hold derivatives
+        if (prog.hasSideEffects())
+            return {NAN, NAN};
+
+        bind(prog);
+        _duals.resizeFast(prog.registers());
+
+        Dual* const         r = _duals.data();
+        const size_t* const s = _slots.data();
+
+        for (const Instruction& ins : prog.code())
         {
-            if (_stack.popTop().integer() != 2)
-            {
-                error(
-                    "expected two argument to the "
-                    "supplied math function");
+            Dual* d = r + ins.dst;
+
+            // clang-format off
+            switch (ins.op) {
+            case OpConst : d[0] = duConst(ins.value);                          break;
+            case OpLoad  :
+                d[0] = ins.index == slot ? Dual{x, 1} : duConst(_variables[s[ins.index]].v);
+                break;
+            case OpMove  : d[0] = d[1];                                        break;
+            case OpAdd   : d[0] = duAdd(d[0], d[1]);                           break;
+            case OpSub   : d[0] = duSub(d[0], d[1]);                           break;
+            case OpMul   : d[0] = duMul(d[0], d[1]);                           break;
+            case OpDiv   : d[0] = duDiv(d[0], d[1]);                           break;
+            case OpPow   : d[0] = duPow(d[0], d[1]);                           break;
+            case OpMod   : d[0] = duMod(d[0], d[1]);                           break;
+            case OpAtan2 : d[0] = duAtan2(d[0], d[1]);                         break;
+            case OpFmod  : d[0] = duFmod(d[0], d[1]);                          break;
+            case OpNeg   : d[0] = duNeg(d[0]);                                 break;
+            case OpAbs   : d[0] = duAbs(d[0]);                                 break;
+            case OpAcos  : d[0] = duAcos(d[0]);                                break;
+            case OpAsin  : d[0] = duAsin(d[0]);                                break;
+            case OpAtan  : d[0] = duAtan(d[0]);                                break;
+            case OpCeil  : d[0] = duCeil(d[0]);                                break;
+            case OpCos   : d[0] = duCos(d[0]);                                 break;
+            case OpCosh  : d[0] = duCosh(d[0]);                                break;
+            case OpExp   : d[0] = duExp(d[0]);                                 break;
+            case OpFloor : d[0] = duFloor(d[0]);                               break;
+            case OpLog   : d[0] = duLog(d[0]);                                 break;
+            case OpLog10 : d[0] = duLog10(d[0]);                               break;
+            case OpSin   : d[0] = duSin(d[0]);                                 break;
+            case OpSinh  : d[0] = duSinh(d[0]);                                break;
+            case OpSqrt  : d[0] = duSqrt(d[0]);                                break;
+            case OpTan   : d[0] = duTan(d[0]);                                 break;
+            case OpTanh  : d[0] = duTanh(d[0]);                                break;
+            case OpSqr   : d[0] = duSqr(d[0]);                                 break;
+            case OpAddK  : d[0] = duAdd(d[0], duConst(ins.value));             break;
+            case OpSubK  : d[0] = duSub(d[0], duConst(ins.value));             break;
+            case OpRSubK : d[0] = duSub(duConst(ins.value), d[0]);             break;
+            case OpMulK  : d[0] = duMul(d[0], duConst(ins.value));             break;
+            case OpRDivK : d[0] = duDiv(duConst(ins.value), d[0]);             break;
+            case OpPowK  : d[0] = duPow(d[0], duConst(ins.value));             break;
+            case OpAssign:
+            case OpGroup :
+            case OpNone  :
+            default:
+                break;
             }
-            const R64& b = _stack.popTop().v;
-            const R64& a = _stack.popTop().v;
-            push(f(a, b));
+            // clang-format on
         }
-        else
-            error(
-                "supplied math function requires "
-                "at least three elements on the stack.");
+
+        const U16 depth = prog.depth();
+
+        Dual res = depth > 0 ? r[depth - 1] : duConst(0);
+        if (std::isnan(res.v))
+            res.d = NAN;
+        return res;
     }
 
-    double lMod(const double a, const double b)
+    bool Statement::executeNative(const Program& code,
+                                  const U32      slot,
+                                  const R64*     xs,
+                                  R64*           ys,
+                                  const size_t   n)
     {
-        const double r = remainder(a, b);
-        return r < 0 ? b + r : r;
+        // code is _special here, recompiled when it changes
+        if (&code != &_special)
+            return false;
+
+        if (!_nativeValid)
+        {
+            _nativeValid = true;
+            _native.compile(code, slot);
+        }
+        if (_native.empty())
+            return false;
+
+        // the spill area needs to be 16 byte aligned
+        _spill.resizeFast(ValueList::SizeType(_native.spillSize() + 2));
+        R64* const spill = (R64*)((uintptr_t(_spill.data()) + 15) & ~uintptr_t(15));
+
+        _native.execute(spill, _values.data(), xs, ys, n);
+        return true;
     }
 
-    void Statement::eval(const Symbol* sy)
+    const Program& Statement::specialize(const Program& prog, const U32 slot)
     {
-        // clang-format off
-    switch (sy->type()) {
-    case Numerical  : push(sy);         break;
-    case Identifier : store(sy);        break;
-    case MathPi     : push(Pi64);       break;
-    case MathE      : push(E64);        break;
-    case Add        : add();            break;
-    case Sub        : sub();            break;
-    case Neg        : neg();            break;
-    case Mul        : mul();            break;
-    case Div        : div();            break;
-    case Pow        : pow();            break;
-    case Mod        : mod();            break;
-    case Assignment : assign();         break;
-    case Grouping   : group();          break;
-    case MathSin    : mathFncA1(sin);   break;
-    case MathAtan   : mathFncA1(atan);  break;
-    case MathAbs    : mathFncA1(fabs);  break;
-    case MathAcos   : mathFncA1(acos);  break;
-    case MathAsin   : mathFncA1(asin);  break;
-    case MathAtan2  : mathFncA2(atan2); break;
-    case MathCeil   : mathFncA1(ceil);  break;
-    case MathCos    : mathFncA1(cos);   break;
-    case MathCosh   : mathFncA1(cosh);  break;
-    case MathExp    : mathFncA1(exp);   break;
-    case MathFabs   : mathFncA1(fabs);  break;
-    case MathFloor  : mathFncA1(floor); break;
-    case MathFmod   : mathFncA2(lMod);  break;
-    case MathLog    : mathFncA1(log);   break;
-    case MathLog10  : mathFncA1(log10); break;
-    case MathPow    : mathFncA2(::pow); break;
-    case MathSinh   : mathFncA1(sinh);  break;
-    case MathSqrt   : mathFncA1(sqrt);  break;
-    case MathTan    : mathFncA1(tan);   break;
-    case MathTanh   : mathFncA1(tanh);  break;
-    case UserFunction: 
-    case None:
-    case Not:
-    case BitwiseNot:
-    default:
-        break;
+        if (&prog == &_special || prog.hasSideEffects())
+            return prog;
+
+        bind(prog);
+
+        const U32 n       = U32(prog.names().size());
+        bool      changed = _special.id() != prog.id() ||
+                       _specialSlot != slot ||
+                       _values.size() != n;
+
+        for (U32 i = _values.size(); i < n; ++i)
+            _values.push_back(0);
+        _values.resizeFast(n);
+
+        for (U32 i = 0; i < n; ++i)
+        {
+            const R64 v = _variables[_slots[i]].v;
+            if (i != slot && memcmp(&v, &_values[i], sizeof(R64)) != 0)
+            {
+                _values[i] = v;
+                changed    = true;
+            }
+        }
+
+        if (changed)
+        {
+            _specialSlot = slot;
+            _special.specialize(prog, slot, _values.data());
+            _nativeValid = false;
+        }
+        return _special;
     }
-        // clang-format on
+
+    void Statement::setBackend(const Backend backend)
+    {
+        _backend    = backend;
+        _mismatches = 0;
     }
 
-    R64 Statement::executeImpl(const SymbolArray& val)
+    void Statement::setSlot(const U32 slot, const R64 value)
     {
-        _stack.resizeFast(0);
-        for (const auto& sy : val)
-            eval(sy);
-        // trace(_stack, "RESULTS");
-        return _stack.empty() ? 0 : _stack.top().v;
+        if (slot < _slots.size())
+            _variables[_slots[slot]] = {value};
     }
 
-    void Statement::argError(const char* op)
+    R64 Statement::getSlot(const U32 slot, const R64 def) const
     {
-        error(
-            "not enough arguments "
-            "supplied to the '",
-            op,
-            "' operation ");
+        if (slot < _slots.size())
+            return _variables[_slots[slot]].v;
+        return def;
     }
 
-    R64 Statement::execute(const SymbolArray& val)
+    void Statement::readInputs(const Program& prog, const U32 varying, ValueList& dest)
     {
-        try
+        bind(prog);
+
+        dest.resizeFast(0);
+        for (U32 i = 0; i < _slots.size(); ++i)
         {
-            return executeImpl(val);
+            if (i != varying)
+                dest.push_back(_variables[_slots[i]].v);
         }
-        catch (...)
+    }
+
+    void Statement::writeInputs(const Program& prog, const U32 varying, const ValueList& src)
+    {
+        bind(prog);
+
+        for (U32 i = 0, j = 0; i < _slots.size() && j < src.size(); ++i)
         {
-            _stack.resizeFast(0);
-            return 0;
+            if (i != varying)
+                setSlot(i, src[j++]);
         }
     }
 
@@ -372,33 +583,29 @@ namespace Jam::Eq
 
     R64 Statement::peek(I32 idx)
     {
-        idx = (_stack.topI() - idx);
-        if (idx >= 0 && idx < _stack.sizeI())
-            return _stack[idx].v;
+        idx = I32(_depth) - 1 - idx;
+        if (idx >= 0 && idx < I32(_depth))
+            return _registers[idx];
         return 0;
     }
 
     void Statement::get(const String& name, ValueList& dest)
     {
         dest.resizeFast(0);
-        const U32 hashKey = (U32)get(name, -1);
 
-        if (const size_t idx = _groups.find(hashKey);
-            idx != JtNpos)
+        const R64 handle = get(name, -1);
+        if (!(handle >= InitialHash))
+            return;
+
+        const U64 key   = U64(handle) - InitialHash;
+        const U64 index = key & ((1u << GroupIndexBits) - 1);
+
+        if (key >> GroupIndexBits == _generation && index < _groups.size())
         {
-            if (ValueGrouping* vg = _groups.at(idx);
-                vg != nullptr)
-            {
-                for (I32 i = vg->sizeI() - 1; i >= 0; --i)
-                    dest.push_back(vg->at(i).v);
-            }
+            const auto& [first, size] = _groups[GroupArray::SizeType(index)];
+            for (U32 i = 0; i < size; ++i)
+                dest.push_back(_groupValues[ValueList::SizeType(first + i)]);
         }
     }
 
-    Statement::~Statement()
-    {
-        for (const auto& ele : _groups)
-            delete ele.second;
-    }
-
 }  // namespace Jam::Eq
@@ -20,54 +20,85 @@
 -------------------------------------------------------------------------------
 */
 #pragma once
+#include "Equation/Dual.h"
+#include "Equation/Interval.h"
+#include "Equation/Native.h"
+#include "Equation/Program.h"
 #include "Equation/StackValue.h"
 #include "Equation/StmtParser.h"
 
 namespace Jam::Eq
 {
-    typedef double (*WrapFuncA1)(double a1);
-    typedef double (*WrapFuncA2)(double a1, double a2);
+    using SlotArray = SimpleArray<size_t>;
 
-    class Statement
+    // The elements of one list value, as a range of the list storage.
+    struct GroupRange
     {
-    private:
-        EvalStack     _stack;
-        EvalHash      _variables;
-        EvalGroupHash _groups;
-        U32           _hashCount{InitialHash};
-
-        void push(const R64&    v,
-                  const size_t& idx  = JtNpos,
-                  U8            flag = StackValue::Value);
-
-        void push(const Symbol* sy);
-
-        void store(const Symbol* sym);
-
-        void add();
-        void sub();
-        void neg();
-        void mul();
-        void div();
-        void mod();
-        void pow();
-        void group();
-        void assign();
-        void mathFncA1(WrapFuncA1 f);
-        void mathFncA2(WrapFuncA2 f);
+        U32 first;
+        U32 size;
+    };
 
-        void eval(const Symbol* sy);
+    using GroupArray = SimpleArray<GroupRange>;
 
-        R64 executeImpl(const SymbolArray& val);
+    // Number of samples evaluated per instruction in executeBatch.
+    constexpr U32 BatchWidth = 64;
 
-        template <typename... Args>
-        [[noreturn]] void error(Args&&... args);
+    enum Backend
+    {
+        // Evaluate with the bytecode interpreter.
+        BackendInterpreter,
+        // Evaluate pure programs with native code when it is available,
+        // and with the interpreter otherwise.
+        BackendNative,
+        // Evaluate with both, count the samples that differ and keep the
+        // interpreter's result.
+        BackendCompare,
+    };
 
-        [[noreturn]] void argError(const char*);
+    class Statement
+    {
+    private:
+        EvalHash      _variables;
+        ValueList     _groupValues;
+        GroupArray    _groups;
+        U32           _execution{0};
+        U32           _groupExecution{0};
+        U32           _generation{0};
+        ValueList     _registers;
+        ValueList     _lanes;
+        SlotArray     _slots;
+        U32           _bound{0};
+        U16           _depth{0};
+        Program       _scratch;
+        Program       _special;
+        ValueList     _values;
+        U32           _specialSlot{JtNpos32};
+        Native        _native;
+        ValueList     _spill;
+        IntervalArray _intervals;
+        DualArray     _duals;
+        bool          _nativeValid{false};
+        Backend       _backend{BackendNative};
+        U32           _mismatches{0};
+
+        void group(R64* dst, U32 nr);
+
+        R64 executeImpl(const Program& prog);
+
+        void executeBlock(const Program& prog,
+                          size_t         slot,
+                          const R64*     xs,
+                          R64*           ys,
+                          U32            n);
+
+        bool executeNative(const Program& code,
+                           U32            slot,
+                           const R64*     xs,
+                           R64*           ys,
+                           size_t         n);
 
     public:
         Statement() = default;
-        ~Statement();
 
         void set(const String& name, R64 value);
 
@@ -81,17 +112,115 @@ namespace Jam::Eq
 
         R64 peek(I32 idx);
 
+        /**
+         * \brief Copies the list held by the named variable into dest.
+         *
+         * Lists are kept until the next execution that creates lists,
+         * after which older handles read as empty.
+         */
         void get(const String& name, ValueList& dest);
 
         R64 execute(const SymbolArray& val);
+
+        R64 execute(const Program& prog);
+
+        /**
+         * \brief Resolves the names of the supplied program to variable
+         * slots. The resolution is kept until a different program is bound,
+         * so repeated calls with the same program are free.
+         */
+        void bind(const Program& prog);
+
+        /**
+         * \brief Sets the variable at the supplied index of the bound
+         * program's names() without a hash lookup.
+         */
+        void setSlot(U32 slot, R64 value);
+
+        R64 getSlot(U32 slot, R64 def = 0) const;
+
+        /**
+         * \brief Binds prog and copies the values of its variables to
+         * dest in names() order, leaving out the one at varying.
+         *
+         * With writeInputs, this hands the state a program reads from one
+         * statement to another, such as values assigned by other programs.
+         */
+        void readInputs(const Program& prog, U32 varying, ValueList& dest);
+
+        // Binds prog and sets its variables from src, as read by readInputs.
+        void writeInputs(const Program& prog, U32 varying, const ValueList& src);
+
+        /**
+         * \brief Returns prog with every variable except the one at the
+         * supplied slot replaced by its current value, so the parts that
+         * do not depend on it are computed once here instead of per sample.
+         *
+         * The result is kept until prog, the slot or one of the values
+         * changes, and stays valid until the next call.
+         */
+        const Program& specialize(const Program& prog, U32 slot);
+
+        /**
+         * \brief Evaluates prog for each of the n values in xs, assigned
+         * to the variable at the supplied slot, and writes the results to
+         * ys. Pure programs are specialized on the slot first.
+         */
+        void executeBatch(const Program& prog,
+                          const String&  name,
+                          const R64*     xs,
+                          R64*           ys,
+                          size_t         n);
+
+        void executeBatch(const Program& prog,
+                          U32            slot,
+                          const R64*     xs,
+                          R64*           ys,
+                          size_t         n);
+
+        /**
+         * \brief Evaluates prog over every value in x assigned to the
+         * variable at the supplied slot, and returns an interval that
+         * encloses all of the results. Other variables keep their value.
+         *
+         * Programs with side effects are not evaluated and return an
+         * unbounded interval.
+         */
+        Interval executeInterval(const Program&  prog,
+                                 U32             slot,
+                                 const Interval& x);
+
+        /**
+         * \brief Evaluates prog with x assigned to the variable at the
+         * supplied slot, and returns its value along with the derivative
+         * with respect to that variable. Other variables keep their value.
+         *
+         * The derivative is NaN where the value is. Programs with side
+         * effects are not evaluated and return NaN for both.
+         */
+        Dual executeDual(const Program& prog, U32 slot, R64 x);
+
+        /**
+         * \brief Selects how executeBatch evaluates pure programs.
+         * The default is BackendNative.
+         */
+        void setBackend(Backend backend);
+
+        Backend backend() const;
+
+        // The number of samples that differed between the two
+        // backends while comparing them.
+        U32 mismatches() const;
     };
 
-    template <typename... Args>
-    void Statement::error(Args&&... args)
+    inline Backend Statement::backend() const
+    {
+        return _backend;
+    }
+
+    inline U32 Statement::mismatches() const
     {
-        OutputStringStream stream;
-        ((stream << std::forward<Args>(args)), ...);
-        throw Exception(stream.str());
+        return _mismatches;
     }
 
 }  // namespace Jam::Eq
@@ -35,9 +35,6 @@ namespace Jam::Eq
 
     StmtParser::~StmtParser()
     {
-        for (const auto& symbol : _symbols)
-            delete symbol;
-
         delete _scanner;
         _scanner = nullptr;
     }
@@ -49,25 +46,31 @@ namespace Jam::Eq
 
     void StmtParser::reset()
     {
-        for (const auto& symbol : _symbols)
-            delete symbol;
+        _pool.reset();
         _symbols.resizeFast(0);
         cleanup();
     }
 
     Symbol* StmtParser::createSymbol(const int8_t& type)
     {
-        Symbol* node = new Symbol((SymbolType)type);
+        Symbol* node = _pool.create((SymbolType)type);
+        _symbols.push_back(node);
+        return node;
+    }
+
+    Symbol* StmtParser::createSymbol(const int8_t& type, const StringView name)
+    {
+        Symbol* node = _pool.create((SymbolType)type, name);
         _symbols.push_back(node);
         return node;
     }
 
-    String StmtParser::string(const size_t& idx) const
+    StringView StmtParser::string(const size_t& idx) const
     {
         return _scanner->string(idx);
     }
 
-    String StmtParser::stringToken(const int32_t& idx)
+    StringView StmtParser::stringToken(const int32_t& idx)
     {
         return _scanner->string(token(idx).index());
     }
@@ -134,8 +137,7 @@ namespace Jam::Eq
 
             createSymbol(Numerical)
                 ->setValue(state.commaCount() + 1);
-            createSymbol(UserFunction)
-                ->setName(string(s0));
+            createSymbol(UserFunction, string(s0));
         }
         else
         {
@@ -179,9 +181,7 @@ namespace Jam::Eq
         // <Op3> ::= Id
         if (t0 == TOK_IDENTIFIER)
         {
-            createSymbol(Identifier)
-                ->setName(
-                    stringToken(0));
+            createSymbol(Identifier, stringToken(0));
             advanceCursor();
             return;
         }
@@ -323,9 +323,7 @@ namespace Jam::Eq
             t1 == TOK_EQUALS &&
             isOpenToken(t2))
         {
-            createSymbol(Identifier)
-                ->setName(
-                    stringToken(0));
+            createSymbol(Identifier, stringToken(0));
             advanceCursor(3);
 
             ruleCsv(state, &StmtParser::ruleOp);
@@ -350,9 +348,7 @@ namespace Jam::Eq
             t1 == TOK_EQUALS &&
             !isOpenToken(t2))
         {
-            createSymbol(Identifier)
-                ->setName(
-                    stringToken(0));
+            createSymbol(Identifier, stringToken(0));
             advanceCursor(2);
             ruleAsn(state);
             createSymbol(Assignment);
@@ -373,24 +369,19 @@ namespace Jam::Eq
             ruleOp(state);
     }
 
-    void StmtParser::parseImpl(IStream& input)
+    void StmtParser::parseImpl(const StringView source)
     {
         // make sure the token cursor is at zero
-        // initially and attach the input stream
+        // initially and attach the source text
         // to the scanner
         reset();
-        _cursor = 0;
-        _scanner->attach(&input, PathUtil(_file));
+        _scanner->attach(source, PathUtil(_file));
 
         CallState state = CallState{Clamp<I16>(_maxDepth, 0x10, 0x800)};
 
-        while (_cursor <= (int32_t)_tokens.size())
+        // <Eq> ::=
+        while (tokenType(0) != TOK_EOF)
         {
-            // <Eq> ::=
-            if (const int8_t tok = token(0).type();
-                tok == TOK_EOF)
-                break;
-
             const int32_t op = _cursor;
 
             // <Eq> ::= <S0>
@@ -408,9 +399,39 @@ namespace Jam::Eq
         // nadda
     }
 
+    void StmtParser::tokenize(const StringView text, String& dest)
+    {
+        cleanup();
+        _scanner->attach(text, PathUtil(_file));
+
+        StmtScanner* scanner = (StmtScanner*)_scanner;
+        dest.clear();
+
+        Token tok;
+        do
+        {
+            scanner->scan(tok);
+            dest.push_back(char(tok.type()));
+
+            if (tok.type() == TOK_IDENTIFIER)
+            {
+                const StringView name = scanner->string(tok.index());
+                dest.append(name.data(), name.size());
+                dest.push_back(' ');
+            }
+            else if (tok.type() == TOK_FLOAT)
+            {
+                const R64 value = scanner->real(tok.index());
+                dest.append((const char*)&value, sizeof(R64));
+            }
+        } while (tok.type() != TOK_EOF);
+
+        cleanup();
+    }
+
     void StmtParser::cleanup()
     {
-        _tokens.clear();
+        resetTokens();
         if (_scanner)
             ((StmtScanner*)_scanner)->cleanup();
     }
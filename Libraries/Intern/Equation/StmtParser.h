@@ -21,6 +21,7 @@
 */
 #pragma once
 #include "Equation/Symbol.h"
+#include "Equation/SymbolPool.h"
 #include "Utils/ParserBase/ParserBase.h"
 #include "Utils/String.h"
 
@@ -34,21 +35,24 @@ namespace Jam::Eq
     {
     private:
         SymbolArray _symbols;
+        SymbolPool  _pool;
         I16         _maxDepth{0x80};
 
         using Parameter = void (StmtParser::*)(CallState& state);
 
     private:
-        void parseImpl(IStream& input) override;
+        void parseImpl(StringView source) override;
         void writeImpl(OStream& output, int format) override;
 
         void cleanup();
 
         Symbol* createSymbol(const int8_t& type);
 
-        String string(const size_t& idx) const;
+        Symbol* createSymbol(const int8_t& type, StringView name);
 
-        String stringToken(const int32_t& idx);
+        StringView string(const size_t& idx) const;
+
+        StringView stringToken(const int32_t& idx);
 
         R64 numericalToken(const int32_t& idx);
 
@@ -79,6 +83,13 @@ namespace Jam::Eq
         ~StmtParser() override;
 
         const SymbolArray& symbols() const;
+
+        /**
+         * \brief Scans text without parsing it, and writes a key for its
+         * token sequence to dest. Identifiers and numbers are keyed by
+         * value, so texts with equal keys parse to the same symbols.
+         */
+        void tokenize(StringView text, String& dest);
     };
 
 }  // namespace Jam::Eq
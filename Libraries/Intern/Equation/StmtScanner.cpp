@@ -22,6 +22,7 @@
 #include "Equation/StmtScanner.h"
 #include "Equation/Token.h"
 #include "Utils/Char.h"
+#include "Utils/PerfectHash.h"
 
 namespace Jam::Eq
 {
@@ -33,89 +34,67 @@ namespace Jam::Eq
         ScannerBase::cleanup();
     }
 
-    TokenType filterKeyword(const ScratchBuffer& input)
+    constexpr PerfectHash<TokenType, 64> KeywordTable(
+        Keywords,
+        KeywordMax,
+        [](const Keyword& kw) { return StringView(kw.word, kw.max); },
+        [](const Keyword& kw) { return kw.token; });
+
+    TokenType filterKeyword(const StringView& input)
     {
-        const char*  test = input.data();
-        const size_t al   = input.size()-1;
-        for (const auto& [word, token, bl] : Keywords)
-        {
-            if (Char::equals(test, al, word, bl))
-                return token;
-        }
-        return TOK_NULL;
+        TokenType token = TOK_NULL;
+        KeywordTable.find(input, token);
+        return token;
     }
 
     void StmtScanner::scanIdentifier(Token& tok)
     {
-        int ch = _stream->peek();
-        if (!isLetter(ch))
+        if (!isLetter(peek()))
             syntaxError("expected the quote character '\"'");
 
-        _buf.resizeFast(0);
-
-        ch = _stream->get();
-        while (isValidIdentifier(ch))
-        {
-            _buf.push_back((char)ch);
-            ch = _stream->get();
-        }
-        _buf.push_back(0x00);
+        const char* first = cursor();
+        while (_cur < _end && isValidIdentifier((uint8_t)*_cur))
+            ++_cur;
 
-        if (ch > 0)
-            _stream->putback((char)ch);
-
-        if (const TokenType rt = filterKeyword(_buf);
+        const StringView name = slice(first);
+        if (const TokenType rt = filterKeyword(name);
             rt != TOK_NULL)
         {
             tok.setType(rt);
         }
         else
         {
-            tok.setIndex(
-                ScannerBase::save(
-                    {
-                        _buf.data(),
-                    })
-            );
+            tok.setIndex(ScannerBase::save(name));
             tok.setType(TOK_IDENTIFIER);
         }
     }
 
     void StmtScanner::scanNumber(Token& tok)
     {
-        int ch = _stream->peek();
-        if (!isDecimal(ch))
+        if (!isDecimal(peek()))
             syntaxError("expected a decimal");
 
         bool hasExtra = false;
 
-        _buf.resizeFast(0);
-        ch = _stream->get();
-
-        while (isDecimal(ch) ||
-               (!hasExtra && isInFloatSet1(ch)) ||
-               (hasExtra && isInFloatSet2(ch)))
+        const char* first = cursor();
+        while (_cur < _end)
         {
+            const int ch = (uint8_t)*_cur;
+            if (!(isDecimal(ch) ||
+                  (!hasExtra && isInFloatSet1(ch)) ||
+                  (hasExtra && isInFloatSet2(ch))))
+                break;
+
             if (ch == 'E' || ch == 'e')
                 hasExtra = true;
-
-            _buf.push_back(int8_t(ch));
-
-            ch = _stream->get();
-        }
-
-        if (ch > 0)
-        {
-            // put back the symbol that
-            // tested not to be a digit.
-            _stream->putback((char)ch);
+            ++_cur;
         }
 
-        if (_buf.sizeI() > 0)
+        if (const StringView number = slice(first);
+            !number.empty())
         {
-            _buf.push_back('\0');
-            const double v = Char::toDouble(_buf.data());
-            _buf.resizeFast(0);
+            double v = 0.0;
+            Char::fromChars(number, v);
 
             tok.setIndex(save(v));
             tok.setType(TOK_FLOAT);
@@ -128,13 +107,13 @@ namespace Jam::Eq
 
     void StmtScanner::scan(Token& tok)
     {
-        if (_stream == nullptr)
+        if (_cur == nullptr)
             syntaxError("No supplied stream");
 
         tok.clear();
 
         int ch;
-        while ((ch = _stream->get()) > 0)
+        while ((ch = get()) > 0)
         {
             tok.setLine(_line);
 
@@ -142,11 +121,11 @@ namespace Jam::Eq
             {
             case UpperCaseAz:
             case LowerCaseAz:
-                _stream->putback((char)ch);
+                putback(ch);
                 scanIdentifier(tok);
                 return;
             case Digits09:
-                _stream->putback((char)ch);
+                putback(ch);
                 scanNumber(tok);
                 return;
             case '=':
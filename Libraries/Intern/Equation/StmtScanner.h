@@ -21,19 +21,16 @@
 */
 #pragma once
 #include "Equation/Token.h"
-#include "Utils/Array.h"
 #include "Utils/ParserBase/ScannerBase.h"
 
 namespace Jam::Eq
 {
-    using DoubleTable   = IndexCache<double>;
-    using ScratchBuffer = SimpleArray<char>;
+    using DoubleTable = IndexCache<double>;
 
     class StmtScanner final : public ScannerBase
     {
     private:
-        DoubleTable   _doubles;
-        ScratchBuffer _buf;
+        DoubleTable _doubles;
 
         void scanNumber(Token& tok);
 
@@ -24,13 +24,13 @@
 
 namespace Jam::Eq
 {
+    const String Symbol::Unnamed;
+
     Symbol::Symbol(const SymbolType tok) :
         _type(tok)
     {
     }
 
-    Symbol::~Symbol() = default;
-
     void Symbol::print() const
     {
         OutputStringStream oss;
@@ -46,7 +46,7 @@ namespace Jam::Eq
             out << SetD({_value}, 0);
             break;
         case Identifier:
-            out << SetS({_name});
+            out << SetS({name()});
             break;
         case Grouping:
             out << "GR";
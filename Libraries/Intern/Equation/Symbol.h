@@ -20,6 +20,7 @@
 -------------------------------------------------------------------------------
 */
 #pragma once
+#include "Equation/NameTable.h"
 #include "Math/Integer.h"
 #include "Math/Real.h"
 #include "Utils/Array.h"
@@ -75,16 +76,19 @@ namespace Jam::Eq
     class Symbol
     {
     private:
-        SymbolType _type{None};
-        R64        _value{0};
-        String     _name{};
+        SymbolType       _type{None};
+        U32              _name{JtNpos32};
+        R64              _value{0};
+        const NameTable* _names{nullptr};
+
+        static const String Unnamed;
 
     public:
         Symbol() = default;
         explicit Symbol(SymbolType tok);
-        ~Symbol();
 
-        void setName(const String& str);
+        // Refers to entry idx of the supplied table.
+        void setName(const NameTable* names, U32 idx);
 
         void setValue(I32 integer);
 
@@ -96,6 +100,8 @@ namespace Jam::Eq
 
         const String& name() const;
 
+        U32 nameIndex() const;
+
         R64 value() const;
 
         void print() const;
@@ -118,12 +124,18 @@ namespace Jam::Eq
         _type = value;
     }
 
-    inline void Symbol::setName(const String& str)
+    inline void Symbol::setName(const NameTable* names, const U32 idx)
     {
-        _name = str;
+        _names = names;
+        _name  = idx;
     }
 
     inline const String& Symbol::name() const
+    {
+        return _names && _name != JtNpos32 ? _names->at(_name) : Unnamed;
+    }
+
+    inline U32 Symbol::nameIndex() const
     {
         return _name;
     }
@@ -0,0 +1,69 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+#include "Equation/NameTable.h"
+#include "Equation/Symbol.h"
+#include "Utils/Arena.h"
+
+namespace Jam::Eq
+{
+    /**
+     * \brief Allocates symbols from an Arena.
+     *
+     * Resetting the pool clears the arena, which keeps its largest
+     * block, so parsing text of a similar size again does not allocate.
+     */
+    class SymbolPool
+    {
+    public:
+        // The number of symbols that fit in the first arena block.
+        static constexpr U32 BlockSize = 256;
+
+        // Once the table holds more names than this, reset clears it.
+        static constexpr U32 NameLimit = 1024;
+
+    private:
+        Arena     _arena{sizeof(Symbol) * BlockSize};
+        NameTable _names;
+
+    public:
+        SymbolPool() = default;
+
+        SymbolPool(const SymbolPool&)            = delete;
+        SymbolPool& operator=(const SymbolPool&) = delete;
+
+        Symbol* create(SymbolType type);
+
+        Symbol* create(SymbolType type, StringView name);
+
+        // Invalidates every symbol created since the last reset.
+        void reset();
+
+        const NameTable& names() const;
+    };
+
+    inline const NameTable& SymbolPool::names() const
+    {
+        return _names;
+    }
+
+}  // namespace Jam::Eq
@@ -0,0 +1,233 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include "Utils/Exception.h"
+#include "Utils/String.h"
+
+namespace Jam
+{
+    /**
+     * \brief Bump allocator for objects that are released all at once.
+     *
+     * Memory is handed out from large blocks and is only returned by
+     * clear or the destructor, so only trivially destructible types may
+     * be placed in it.
+     */
+    class Arena
+    {
+    public:
+        static constexpr size_t DefaultBlockSize = 0x10000;
+        static constexpr size_t MaxBlockSize     = 0x400000;
+
+    private:
+        struct Block
+        {
+            Block* next;
+            size_t size;
+        };
+
+        Block* _first{nullptr};
+        Block* _block{nullptr};
+        char*  _cur{nullptr};
+        char*  _end{nullptr};
+        size_t _blockSize{DefaultBlockSize};
+        size_t _blocks{0};
+        size_t _used{0};
+
+        void* grow(size_t size, size_t align);
+
+        void enter(Block* block);
+
+        void release(Block* block);
+
+    public:
+        explicit Arena(size_t blockSize = DefaultBlockSize);
+
+        Arena(const Arena&) = delete;
+
+        Arena& operator=(const Arena&) = delete;
+
+        ~Arena();
+
+        void* allocate(size_t size, size_t align = alignof(std::max_align_t));
+
+        template <typename T, typename... Args>
+        T* construct(Args&&... args);
+
+        template <typename T>
+        T* allocateArray(size_t count);
+
+        /**
+         * \brief Copies str into the arena.
+         * \return A view of the copy, which is null terminated.
+         */
+        StringView copy(const StringView& str);
+
+        /**
+         * \brief Releases everything that was allocated.
+         *
+         * The blocks are kept and handed out again in the same order,
+         * so a reused arena does not go back to the heap until it needs
+         * more than it held before.
+         */
+        void clear();
+
+        // The number of heap blocks currently held.
+        size_t blocks() const;
+
+        // The number of bytes handed out since the last clear.
+        size_t used() const;
+    };
+
+    inline Arena::Arena(const size_t blockSize) :
+        _blockSize{blockSize < 0x100 ? 0x100 : blockSize}
+    {
+    }
+
+    inline Arena::~Arena()
+    {
+        release(_first);
+        _first = nullptr;
+        _block = nullptr;
+    }
+
+    inline void Arena::release(Block* block)
+    {
+        while (block)
+        {
+            Block* next = block->next;
+            std::free(block);
+            block = next;
+        }
+    }
+
+    inline void* Arena::allocate(const size_t size, const size_t align)
+    {
+        const auto base = (uintptr_t)_cur;
+        const auto mem  = (base + (align - 1)) & ~(uintptr_t)(align - 1);
+
+        if (_cur && mem + size <= (uintptr_t)_end)
+        {
+            _cur = (char*)(mem + size);
+            _used += size;
+            return (void*)mem;
+        }
+        return grow(size, align);
+    }
+
+    inline void Arena::enter(Block* block)
+    {
+        _block = block;
+        _cur   = (char*)(block + 1);
+        _end   = _cur + block->size;
+    }
+
+    inline void* Arena::grow(const size_t size, const size_t align)
+    {
+        // reuse the next block held from before a clear if it fits
+        Block* next = _block ? _block->next : _first;
+        if (next && size + align <= next->size)
+        {
+            enter(next);
+            return allocate(size, align);
+        }
+
+        // large requests get a block of their own
+        size_t capacity = _blockSize;
+        if (size + align > capacity)
+            capacity = size + align;
+
+        const auto block = (Block*)std::malloc(sizeof(Block) + capacity);
+        if (!block)
+            throw Exception("arena allocation of ", capacity, " bytes failed");
+
+        // linked in front of the held blocks that were too small
+        block->next = next;
+        block->size = capacity;
+        if (_block)
+            _block->next = block;
+        else
+            _first = block;
+        ++_blocks;
+        enter(block);
+
+        if (_blockSize < MaxBlockSize)
+            _blockSize <<= 1;
+        return allocate(size, align);
+    }
+
+    template <typename T, typename... Args>
+    T* Arena::construct(Args&&... args)
+    {
+        static_assert(std::is_trivially_destructible_v<T>,
+                      "arena objects are never destroyed");
+
+        return new (allocate(sizeof(T), alignof(T))) T{std::forward<Args>(args)...};
+    }
+
+    template <typename T>
+    T* Arena::allocateArray(const size_t count)
+    {
+        static_assert(std::is_trivially_destructible_v<T>,
+                      "arena objects are never destroyed");
+
+        if (count == 0)
+            return nullptr;
+
+        T* arr = (T*)allocate(sizeof(T) * count, alignof(T));
+        for (size_t i = 0; i < count; ++i)
+            new (arr + i) T();
+        return arr;
+    }
+
+    inline StringView Arena::copy(const StringView& str)
+    {
+        char* mem = (char*)allocate(str.size() + 1, 1);
+        if (!str.empty())
+            std::memcpy(mem, str.data(), str.size());
+        mem[str.size()] = 0;
+        return {mem, str.size()};
+    }
+
+    inline void Arena::clear()
+    {
+        if (_first)
+            enter(_first);
+        _used = 0;
+    }
+
+    inline size_t Arena::blocks() const
+    {
+        return _blocks;
+    }
+
+    inline size_t Arena::used() const
+    {
+        return _used;
+    }
+
+}  // namespace Jam
@@ -24,6 +24,7 @@
 #endif
 #include "Utils/Char.h"
 #include <bitset>
+#include <charconv>
 #include <cstdlib>
 #include <cstring>
 #include <iomanip>
@@ -170,6 +171,94 @@ namespace Jam
         return toUint64(in.c_str(), def, base);
     }
 
+    namespace
+    {
+        const char* skipSign(const StringView& in)
+        {
+            const char* first = in.data();
+            const char* last  = first + in.size();
+
+            while (first < last && (*first == ' ' || *first == '\t'))
+                ++first;
+            if (first + 1 < last && first[0] == '+' && first[1] != '-')
+                ++first;
+            return first;
+        }
+
+        template <typename T, typename... Args>
+        size_t fromCharsImpl(const StringView& in, T& dest, Args... args)
+        {
+            const char* first = skipSign(in);
+            const char* last  = in.data() + in.size();
+
+            T v{};
+            if (const auto [ptr, ec] = std::from_chars(first, last, v, args...);
+                ec == std::errc())
+            {
+                dest = v;
+                return size_t(ptr - in.data());
+            }
+            return 0;
+        }
+
+        template <typename T>
+        size_t toCharsImpl(char* dest, const T& v)
+        {
+            const auto [ptr, ec] = std::to_chars(dest, dest + Char::MaxNumberLength, v);
+            return ec == std::errc() ? size_t(ptr - dest) : 0;
+        }
+    }  // namespace
+
+    size_t Char::fromChars(const StringView& in, double& dest)
+    {
+        return fromCharsImpl(in, dest);
+    }
+
+    size_t Char::fromChars(const StringView& in, float& dest)
+    {
+        return fromCharsImpl(in, dest);
+    }
+
+    size_t Char::fromChars(const StringView& in, int32_t& dest, const int base)
+    {
+        return fromCharsImpl(in, dest, base);
+    }
+
+    size_t Char::fromChars(const StringView& in, int64_t& dest, const int base)
+    {
+        return fromCharsImpl(in, dest, base);
+    }
+
+    size_t Char::toChars(char* dest, const double v)
+    {
+        return toCharsImpl(dest, v);
+    }
+
+    size_t Char::toChars(char* dest, const float v)
+    {
+        return toCharsImpl(dest, v);
+    }
+
+    size_t Char::toChars(char* dest, const int32_t v)
+    {
+        return toCharsImpl(dest, v);
+    }
+
+    size_t Char::toChars(char* dest, const uint32_t v)
+    {
+        return toCharsImpl(dest, v);
+    }
+
+    size_t Char::toChars(char* dest, const int64_t v)
+    {
+        return toCharsImpl(dest, v);
+    }
+
+    size_t Char::toChars(char* dest, const uint64_t v)
+    {
+        return toCharsImpl(dest, v);
+    }
+
     bool Char::isNullOrEmpty(const char* in)
     {
         return !in || !*in;
@@ -197,7 +286,11 @@ namespace Jam
     float Char::toFloat(const char* in, const float& def)
     {
         if (in && *in)
-            return std::strtof(in, nullptr);
+        {
+            float v = 0.f;
+            fromChars(in, v);
+            return v;
+        }
         return def;
     }
 
@@ -205,10 +298,9 @@ namespace Jam
     {
         if (in && *in)
         {
-            InputStringStream ss(in);
-            DoublePrint a(0);
-            a.from(ss);
-            return (double)a;//std::strtod(in, nullptr);
+            double v = 0.0;
+            fromChars(in, v);
+            return v;
         }
         return def;
     }
@@ -230,16 +322,14 @@ namespace Jam
 
     void Char::toString(String& dest, const float v)
     {
-        std::stringstream stream;
-        stream << v;
-        dest = stream.str();
+        char buf[MaxNumberLength];
+        dest.assign(buf, toChars(buf, v));
     }
 
     void Char::toString(String& dest, const double v)
     {
-        std::stringstream stream;
-        stream << v;
-        dest = stream.str();
+        char buf[MaxNumberLength];
+        dest.assign(buf, toChars(buf, v));
     }
 
     void Char::toString(String& dest, const bool v)
@@ -275,9 +365,8 @@ namespace Jam
 
     void Char::toString(String& dest, const int16_t v)
     {
-        std::ostringstream oss;
-        oss << v;
-        dest = oss.str();
+        char buf[MaxNumberLength];
+        dest.assign(buf, toChars(buf, (int64_t)v));
     }
 
     String Char::toString(const int16_t v)
@@ -289,9 +378,8 @@ namespace Jam
 
     void Char::toString(String& dest, const int32_t v)
     {
-        std::ostringstream oss;
-        oss << v;
-        dest = oss.str();
+        char buf[MaxNumberLength];
+        dest.assign(buf, toChars(buf, (int64_t)v));
     }
 
     String Char::toString(const int32_t v)
@@ -303,9 +391,8 @@ namespace Jam
 
     void Char::toString(String& dest, const int64_t v)
     {
-        std::ostringstream oss;
-        oss << v;
-        dest = oss.str();
+        char buf[MaxNumberLength];
+        dest.assign(buf, toChars(buf, v));
     }
 
     String Char::toString(const int64_t v)
@@ -317,9 +404,8 @@ namespace Jam
 
     void Char::toString(String& dest, const uint16_t v)
     {
-        std::ostringstream oss;
-        oss << v;
-        dest = oss.str();
+        char buf[MaxNumberLength];
+        dest.assign(buf, toChars(buf, (uint64_t)v));
     }
 
     String Char::toString(const uint16_t v)
@@ -331,9 +417,8 @@ namespace Jam
 
     void Char::toString(String& dest, const uint32_t v)
     {
-        std::ostringstream oss;
-        oss << v;
-        dest = oss.str();
+        char buf[MaxNumberLength];
+        dest.assign(buf, toChars(buf, (uint64_t)v));
     }
 
     String Char::toString(const uint32_t v)
@@ -345,9 +430,8 @@ namespace Jam
 
     void Char::toString(String& dest, const uint64_t v)
     {
-        std::ostringstream oss;
-        oss << v;
-        dest = oss.str();
+        char buf[MaxNumberLength];
+        dest.assign(buf, toChars(buf, v));
     }
 
     String Char::toString(const uint64_t v)
@@ -33,6 +33,9 @@ namespace Jam
     class Char
     {
     public:
+        // Large enough for the shortest form of any double or 64 bit integer.
+        static constexpr size_t MaxNumberLength = 32;
+
         static size_t length(const char* input);
 
         static bool equals(const char* a, const char* b, size_t max);
@@ -86,6 +89,39 @@ namespace Jam
                                  uint64_t      def  = (uint64_t)-1,
                                  int           base = 10);
 
+        /**
+         * \brief Locale independent parsing that does not allocate.
+         *
+         * Leading blanks and a '+' sign are skipped.
+         * \return The number of characters consumed, or zero if the input
+         * does not start with a number. In that case dest is unchanged.
+         */
+        static size_t fromChars(const StringView& in, double& dest);
+
+        static size_t fromChars(const StringView& in, float& dest);
+
+        static size_t fromChars(const StringView& in, int32_t& dest, int base = 10);
+
+        static size_t fromChars(const StringView& in, int64_t& dest, int base = 10);
+
+        /**
+         * \brief Writes the shortest text that reads back as exactly v.
+         *
+         * \param dest Must hold at least MaxNumberLength characters.
+         * \return The number of characters written. No terminator is added.
+         */
+        static size_t toChars(char* dest, double v);
+
+        static size_t toChars(char* dest, float v);
+
+        static size_t toChars(char* dest, int32_t v);
+
+        static size_t toChars(char* dest, uint32_t v);
+
+        static size_t toChars(char* dest, int64_t v);
+
+        static size_t toChars(char* dest, uint64_t v);
+
         static bool isNullOrEmpty(const char* in);
 
         static bool toBool(const char* in);
@@ -38,9 +38,16 @@ namespace Jam::CommandLine
             delete op;
     }
 
-    bool Parser::hasSwitch(const String& sw) const
+    bool Parser::hasSwitch(const StringView& sw) const
     {
-        return _switches.find(sw) != _switches.end();
+        // only used while the options are being set up,
+        // before the keys are hashed
+        for (const Switches::Entry& key : _keys)
+        {
+            if (key.key == sw)
+                return true;
+        }
+        return false;
     }
 
     bool Parser::setupParse(int argc, char** argv)
@@ -130,8 +137,8 @@ namespace Jam::CommandLine
                     return -1;
                 }
 
-                auto it = _switches.find(token.getValue());
-                if (it == _switches.end())
+                ParseOption* opt = nullptr;
+                if (!_switches.find(token.getValue(), opt))
                 {
                     OutputStringStream os;
                     os << "unknown option " << token.getValue() << endl;
@@ -140,7 +147,6 @@ namespace Jam::CommandLine
 
                 tmpBuffer.assign(token.getValue());
 
-                ParseOption* opt = it->second;
                 opt->makePresent();
 
                 if (!opt->isOptional())
@@ -352,9 +358,12 @@ namespace Jam::CommandLine
             return false;
         }
 
-        if (sw.shortSwitch != 0)
+        // the keys view the option's own copy of the switch
+        const Switch& own = opt->getSwitch();
+
+        if (own.shortSwitch != 0)
         {
-            if (hasSwitch(String(sw.shortSwitch, 1)))
+            if (hasSwitch(StringView(&own.shortSwitch, 1)))
             {
                 OutputStringStream stream;
                 stream << "Duplicate switch " << sw.shortSwitch;
@@ -378,11 +387,11 @@ namespace Jam::CommandLine
             }
         }
 
-        if (sw.shortSwitch != 0)
-            _switches.insert(make_pair(String(1, sw.shortSwitch), opt));
+        if (own.shortSwitch != 0)
+            _keys.push_back({StringView(&own.shortSwitch, 1), opt});
 
-        if (sw.longSwitch != nullptr)
-            _switches.insert(make_pair(sw.longSwitch, opt));
+        if (own.longSwitch != nullptr)
+            _keys.push_back({StringView(own.longSwitch), opt});
 
         return true;
     }
@@ -414,6 +423,13 @@ namespace Jam::CommandLine
                 result = initializeOption(_options[i], switches[i]);
             }
         }
+
+        if (result && !_switches.build(_keys.data(), _keys.size()))
+        {
+            Console::writeError("Failed to hash the switch table");
+            result = false;
+        }
+        _keys.clear();
         return result;
     }
 
@@ -25,6 +25,7 @@
 #include "Utils/CommandLine/Scanner.h"
 #include "Utils/FileSystem.h"
 #include "Utils/Path.h"
+#include "Utils/PerfectHash.h"
 
 /**
  * \brief Provides classes that handle parsing command line options.
@@ -38,9 +39,10 @@ namespace Jam::CommandLine
     class Parser
     {
     public:
-        typedef std::unordered_map<String, ParseOption*> Switches;
-        typedef std::vector<ParseOption*>                Options;
-        typedef std::vector<String>                      StringArray;
+        typedef PerfectHash<ParseOption*, 0x200> Switches;
+        typedef std::vector<Switches::Entry>     SwitchKeys;
+        typedef std::vector<ParseOption*>        Options;
+        typedef std::vector<String>              StringArray;
 
     private:
         int         _maxLongSwitch{4};
@@ -48,11 +50,12 @@ namespace Jam::CommandLine
         int         _usedOptions{0};
         Scanner     _scanner;
         Switches    _switches;
+        SwitchKeys  _keys;
         StringArray _argumentList;
         Options     _options;
         PathUtil    _programName;
 
-        bool hasSwitch(const String& sw) const;
+        bool hasSwitch(const StringView& sw) const;
 
         bool initializeOption(ParseOption* opt, const Switch& sw);
 
@@ -0,0 +1,159 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Utils/MappedFile.h"
+#include <fstream>
+#ifdef _WIN32
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace Jam
+{
+    MappedFile::MappedFile(const String& path)
+    {
+        open(path);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        close();
+    }
+
+    bool MappedFile::readAll(const String& path)
+    {
+        std::ifstream is(path, std::ios::binary);
+        if (!is.is_open())
+            return false;
+
+        is.seekg(0, std::ios::end);
+        const std::streamoff end = is.tellg();
+        is.seekg(0, std::ios::beg);
+
+        if (end > 0)
+        {
+            _buffer.resize((size_t)end);
+            is.read(_buffer.data(), (std::streamsize)end);
+            _buffer.resize((size_t)is.gcount());
+        }
+
+        _data = _buffer.data();
+        _size = _buffer.size();
+        return true;
+    }
+
+#ifdef _WIN32
+
+    bool MappedFile::open(const String& path)
+    {
+        close();
+
+        const HANDLE file = CreateFileA(path.c_str(),
+                                        GENERIC_READ,
+                                        FILE_SHARE_READ,
+                                        nullptr,
+                                        OPEN_EXISTING,
+                                        FILE_FLAG_SEQUENTIAL_SCAN,
+                                        nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER size;
+        if (GetFileSizeEx(file, &size) && (ULONGLONG)size.QuadPart >= MapThreshold)
+        {
+            // the view keeps the mapping and the file alive,
+            // so both handles can be closed once it exists
+            if (const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr))
+            {
+                if (const void* base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0))
+                {
+                    _data    = (const char*)base;
+                    _size    = (size_t)size.QuadPart;
+                    _mapped  = true;
+                    _mapping = (void*)base;
+                }
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+
+        return _mapped || readAll(path);
+    }
+
+    void MappedFile::close()
+    {
+        if (_mapped)
+            UnmapViewOfFile(_mapping);
+
+        _mapping = nullptr;
+        _mapped  = false;
+        _data    = nullptr;
+        _size    = 0;
+        _buffer.clear();
+    }
+
+#else
+
+    bool MappedFile::open(const String& path)
+    {
+        close();
+
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat st{};
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && (size_t)st.st_size >= MapThreshold)
+        {
+            void* base = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (base != MAP_FAILED)
+            {
+                // the scanners read front to back
+                madvise(base, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+                _data   = (const char*)base;
+                _size   = (size_t)st.st_size;
+                _mapped = true;
+            }
+        }
+        ::close(fd);
+
+        return _mapped || readAll(path);
+    }
+
+    void MappedFile::close()
+    {
+        if (_mapped)
+            munmap((void*)_data, _size);
+
+        _mapped = false;
+        _data   = nullptr;
+        _size   = 0;
+        _buffer.clear();
+    }
+
+#endif
+
+}  // namespace Jam
@@ -0,0 +1,100 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+#include "Utils/String.h"
+
+namespace Jam
+{
+    /**
+     * \brief Read only view of a whole file.
+     *
+     * Files of at least MapThreshold bytes are memory mapped, which
+     * avoids copying them through a stream. Smaller files, and files
+     * that cannot be mapped, are read into an owned buffer instead.
+     * Either way the bytes stay valid until close or destruction.
+     */
+    class MappedFile
+    {
+    public:
+        static constexpr size_t MapThreshold = 0x10000;
+
+    private:
+        const char* _data{nullptr};
+        size_t      _size{0};
+        String      _buffer;
+        bool        _mapped{false};
+#ifdef _WIN32
+        void* _mapping{nullptr};
+#endif
+
+        bool readAll(const String& path);
+
+    public:
+        MappedFile() = default;
+
+        explicit MappedFile(const String& path);
+
+        MappedFile(const MappedFile&) = delete;
+
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        ~MappedFile();
+
+        /**
+         * \brief Replaces the current view with the contents of path.
+         * \return false if the file could not be opened.
+         */
+        bool open(const String& path);
+
+        void close();
+
+        StringView view() const;
+
+        size_t size() const;
+
+        bool isOpen() const;
+
+        // True when the view points into a mapping.
+        bool isMapped() const;
+    };
+
+    inline StringView MappedFile::view() const
+    {
+        return {_data ? _data : "", _size};
+    }
+
+    inline size_t MappedFile::size() const
+    {
+        return _size;
+    }
+
+    inline bool MappedFile::isOpen() const
+    {
+        return _data != nullptr;
+    }
+
+    inline bool MappedFile::isMapped() const
+    {
+        return _mapped;
+    }
+
+}  // namespace Jam
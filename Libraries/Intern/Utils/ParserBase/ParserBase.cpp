@@ -21,7 +21,7 @@
 */
 #include "Utils/ParserBase/ParserBase.h"
 #include <fstream>
-#include <vector>
+#include <iterator>
 #include "Utils/Char.h"
 #include "Utils/ParserBase/ParseError.h"
 #include "Utils/ParserBase/ScannerBase.h"
@@ -31,27 +31,18 @@
 namespace Jam
 {
 
-    void ParserBase::readToken(int32_t n)
+    const TokenBase& ParserBase::token(const int32_t offs)
     {
-        do
-        {
-            TokenBase tok;
-            _scanner->scan(tok);
-            _tokens.push_back(tok);
-        } while (--n > 0);
-    }
+        if (offs < 0 || offs >= Lookahead)
+            error("Failed to read token");
 
-    TokenBase ParserBase::token(const int32_t offs)
-    {
         const int32_t next = offs + _cursor;
 
-        while (next + 1 > (int32_t)_tokens.size())
-            readToken();
-
-        if (next < (int32_t)_tokens.size() && next >= 0)
-            return _tokens.at(next);
-
-        error("Failed to read token");
+        // anything before the cursor has been retired,
+        // so its slot can be reused
+        while (_read <= next)
+            _scanner->scan(_window[_read++ & LookaheadMask]);
+        return _window[next & LookaheadMask];
     }
 
     int8_t ParserBase::tokenType(const int32_t offs)
@@ -64,6 +55,12 @@ namespace Jam
         _cursor += n;
     }
 
+    void ParserBase::resetTokens()
+    {
+        _cursor = 0;
+        _read   = 0;
+    }
+
     [[noreturn]] void ParserBase::throwError(
         const String& message)
     {
@@ -89,17 +86,25 @@ namespace Jam
         if (!path.exists())
             throw Exception("The supplied file '", file, "' does not exist");
 
-        InputFileStream is(file);
-        if (!is.is_open())
+        if (!_map.open(file))
             throw Exception("Failed to open the input file '", file, "'");
 
         _file = path.stem();
+        _source.clear();
 
         // call the implementation
-        parseImpl(is);
+        parseImpl(_map.view());
     }
 
     void ParserBase::read(IStream& is, const String& file)
+    {
+        _map.close();
+        _source.assign(std::istreambuf_iterator(is),
+                       std::istreambuf_iterator<char>());
+        readText(_source, file);
+    }
+
+    void ParserBase::readText(const StringView text, const String& file)
     {
         // save some relatively unique name for the file
         if (_file.empty())
@@ -109,7 +114,7 @@ namespace Jam
             else
                 _file = file;
         }
-        parseImpl(is);
+        parseImpl(text);
     }
 
     void ParserBase::write(const String& file, const int format)
@@ -20,7 +20,7 @@
 -------------------------------------------------------------------------------
 */
 #pragma once
-#include <vector>
+#include "Utils/MappedFile.h"
 #include "Utils/ParserBase/ScannerBase.h"
 #include "Utils/ParserBase/TokenBase.h"
 
@@ -28,12 +28,26 @@ namespace Jam
 {
     class ScannerBase;
 
+    /**
+     * \brief Base class for the recursive descent parsers.
+     *
+     * Tokens are pulled from the scanner on demand into a fixed
+     * lookahead window. A token is retired once the cursor moves past
+     * it, so memory use does not grow with the size of the input.
+     */
     class ParserBase
     {
     public:
-        typedef std::vector<TokenBase> Tokens;
+        // The largest offset passed to token() plus one.
+        // It must be a power of two.
+        static constexpr int32_t Lookahead = 4;
 
     private:
+        static constexpr int32_t LookaheadMask = Lookahead - 1;
+
+        TokenBase _window[Lookahead];
+        int32_t   _read{0};
+
         [[noreturn]] void throwError(const String& message);
 
         size_t line() const;
@@ -41,20 +55,23 @@ namespace Jam
     protected:
         int32_t      _cursor{0};
         ScannerBase* _scanner{nullptr};
-        Tokens       _tokens;
         String       _file;
+        String       _source;
+        MappedFile   _map;
 
-        virtual void parseImpl(IStream& is) = 0;
+        virtual void parseImpl(StringView source) = 0;
 
         virtual void writeImpl(OStream& is, int format) = 0;
 
-        TokenBase token(int32_t offs);
+        // The returned reference is only valid until the cursor advances.
+        const TokenBase& token(int32_t offs);
 
         int8_t tokenType(int32_t offs);
 
         void advanceCursor(int32_t n = 1);
 
-        void readToken(int32_t n = 1);
+        // Drops every token in the window and rewinds the cursor.
+        void resetTokens();
 
         template <typename... Args>
         [[noreturn]] void error(
@@ -69,10 +86,14 @@ namespace Jam
         ParserBase()          = default;
         virtual ~ParserBase() = default;
 
+        // Maps the file, or reads it if it cannot be mapped.
         void read(const String& file);
 
         void read(IStream& is, const String& file = "");
 
+        // Parses text in place. It only needs to outlive the call.
+        void readText(StringView text, const String& file = "");
+
         void write(const String& file, int format = 0);
 
         void write(OStream& os, int format = 0);
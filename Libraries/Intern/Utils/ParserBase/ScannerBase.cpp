@@ -20,39 +20,65 @@
 -------------------------------------------------------------------------------
 */
 #include "Utils/ParserBase/ScannerBase.h"
+#include <iterator>
 #include "Utils/Char.h"
 #include "Utils/ParserBase/ParseError.h"
 
 namespace Jam
 {
     ScannerBase::ScannerBase() :
-        _stream(nullptr),
         _line(0)
     {
     }
 
     void ScannerBase::attach(IStream* stream, const PathUtil& file)
     {
-        _stream = stream;
-        _file   = file;
-        _line   = 1;
+        if (stream == nullptr)
+            syntaxErrorThrow("No supplied stream");
+
+        _source.assign(std::istreambuf_iterator(*stream),
+                       std::istreambuf_iterator<char>());
+        attach(StringView(_source), file);
+    }
+
+    void ScannerBase::open(const String& file)
+    {
+        if (!_map.open(file))
+            throw Exception("Failed to open the input file '", file, "'");
+
+        _source.clear();
+        attach(_map.view(), PathUtil(file));
+    }
+
+    void ScannerBase::attach(const StringView source, const PathUtil& file)
+    {
+        _first = source.empty() ? "" : source.data();
+        _cur   = _first;
+        _end   = _first + source.size();
+        _file  = file;
+        _line  = 1;
     }
 
     void ScannerBase::cleanup()
     {
         _intTable.clear();
         _stringTable.clear();
-        _stream = nullptr;
+        _source.clear();
+        _map.close();
+
+        _first = nullptr;
+        _cur   = nullptr;
+        _end   = nullptr;
     }
 
-    const String& ScannerBase::string(const size_t& i) const
+    StringView ScannerBase::string(const size_t& i) const
     {
         return _stringTable.at(i);
     }
 
     void ScannerBase::string(String& dest, const size_t& i) const
     {
-        _stringTable.at(dest, i);
+        dest = _stringTable.at(i);
     }
 
     int ScannerBase::integer(const size_t& i) const
@@ -72,32 +98,32 @@ namespace Jam
 
     void ScannerBase::scanLineComment()
     {
-        int ch = _stream->peek();
-        while (ch != '\r' && ch != '\n')
+        int ch = peek();
+        while (ch != '\r' && ch != '\n' && ch != -1)
         {
-            ch = _stream->get();
-            if (ch == '\r' && _stream->peek() == '\n')
-                ch = _stream->get();
+            ch = get();
+            if (ch == '\r' && peek() == '\n')
+                ch = get();
         }
         ++_line;
     }
 
     void ScannerBase::scanMultiLineComment()
     {
-        int ch = _stream->peek();
+        int ch = peek();
 
         while (ch > 0)
         {
-            ch = _stream->get();
-            if (ch == MultiLineCommentStop0 && _stream->peek() == MultiLineCommentStop1)
+            ch = get();
+            if (ch == MultiLineCommentStop0 && peek() == MultiLineCommentStop1)
             {
-                _stream->get();
+                get();
                 break;
             }
             if (ch == '\r' || ch == '\n')
             {
-                if (ch == '\r' && _stream->peek() == '\n')
-                    ch = _stream->get();
+                if (ch == '\r' && peek() == '\n')
+                    ch = get();
                 ++_line;
             }
         }
@@ -105,14 +131,14 @@ namespace Jam
 
     void ScannerBase::scanAny(String& dest, char seqStart, char seqEnd)
     {
-        int ch = _stream->get();
+        int ch = get();
         while (ch != seqStart)
         {
-            ch = _stream->get();
+            ch = get();
             if (ch <= 0)
                 syntaxError("end of file scan while searching for ", seqStart);
         }
-        ch = _stream->get();
+        ch = get();
 
         OutputStringStream oss;
         while (ch != seqEnd)
@@ -127,16 +153,16 @@ namespace Jam
                 }
             }
 
-            ch = _stream->get();
+            ch = get();
             if (ch <= 0)
                 syntaxError("end of file scan while searching for ", seqEnd);
 
             if (ch == '\r' || ch == '\n')
             {
-                if (ch == '\r' && _stream->peek() == '\n')
-                    _stream->get();
+                if (ch == '\r' && peek() == '\n')
+                    get();
 
-                ch = _stream->get();
+                ch = get();
                 oss << '\n';
                 ++_line;
             }
@@ -170,15 +196,9 @@ namespace Jam
         dest = code.substr(0, code.size() - 1);
     }
 
-    void ScannerBase::scanWhiteSpace() const
+    void ScannerBase::scanWhiteSpace()
     {
-        int ch = 0;
-        while (ch != -1)
-        {
-            if (isWhiteSpace(_stream->peek()))
-                ch = _stream->get();
-            else
-                break;
-        }
+        while (_cur < _end && isWhiteSpace((uint8_t)*_cur))
+            ++_cur;
     }
 }  // namespace Jam
@@ -22,27 +22,39 @@
 #pragma once
 #include "Utils/FileSystem.h"
 #include "Utils/IndexCache.h"
+#include "Utils/MappedFile.h"
 #include "Utils/ParserBase/TokenBase.h"
 #include "Utils/Path.h"
 
 namespace Jam
 {
-    using StringTable = IndexCache<String>;
+    using StringTable = IndexCache<StringView>;
     using IntTable    = IndexCache<int>;
 
     constexpr char MultiLineCommentStop0 = '-';
     constexpr char MultiLineCommentStop1 = '>';
 
+    /**
+     * \brief Common base for the hand written scanners.
+     *
+     * Input is scanned from one contiguous buffer with a plain pointer
+     * cursor. String payloads are saved as views into that buffer, so
+     * they stay valid until the next attach or cleanup.
+     */
     class ScannerBase
     {
     protected:
-        IStream*    _stream;
+        const char* _first{nullptr};
+        const char* _cur{nullptr};
+        const char* _end{nullptr};
+        String      _source;
+        MappedFile  _map;
         StringTable _stringTable;
         IntTable    _intTable;
         PathUtil    _file;
         size_t      _line;
 
-        size_t save(const String& str)
+        size_t save(const StringView& str)
         {
             return _stringTable.insert(str);
         }
@@ -54,12 +66,23 @@ namespace Jam
 
         virtual void cleanup();
 
+        // Returns the next character or -1 at the end of the input.
+        int get();
+
+        int peek() const;
+
+        // Steps back over ch, if ch was read.
+        void putback(int ch);
+
+        const char* cursor() const;
+
+        StringView slice(const char* from) const;
 
         template <typename... Args>
         [[noreturn]] void syntaxError(
             const String& what, Args&&... args);
 
-        void scanWhiteSpace() const;
+        void scanWhiteSpace();
 
         void scanLineComment();
 
@@ -79,9 +102,18 @@ namespace Jam
 
         virtual void scan(TokenBase& tok) = 0;
 
+        // Copies the stream into an owned buffer, then scans that.
         void attach(IStream* stream, const PathUtil& file);
 
-        const String& string(const size_t& i) const;
+        // Scans source in place. The caller keeps it alive while scanning
+        // and while any saved string is in use.
+        void attach(StringView source, const PathUtil& file);
+
+        // Maps the file, or reads it if it cannot be mapped, then scans
+        // it in place. The bytes stay valid until the next attach or cleanup.
+        void open(const String& file);
+
+        StringView string(const size_t& i) const;
 
         void string(String& dest, const size_t& i) const;
 
@@ -106,6 +138,36 @@ namespace Jam
         return _line;
     }
 
+    inline int ScannerBase::get()
+    {
+        if (_cur < _end)
+            return (uint8_t)*_cur++;
+        return -1;
+    }
+
+    inline int ScannerBase::peek() const
+    {
+        if (_cur < _end)
+            return (uint8_t)*_cur;
+        return -1;
+    }
+
+    inline void ScannerBase::putback(const int ch)
+    {
+        if (ch >= 0 && _cur > _first)
+            --_cur;
+    }
+
+    inline const char* ScannerBase::cursor() const
+    {
+        return _cur;
+    }
+
+    inline StringView ScannerBase::slice(const char* from) const
+    {
+        return {from, (size_t)(_cur - from)};
+    }
+
     // clang-format off
 #define LowerCaseAz                                                   \
     'a' : case 'b' : case 'c' : case 'd' : case 'e' : case 'f' : case 'g' \
@@ -90,6 +90,18 @@ namespace Jam
         construct(oth.fullPath());
     }
 
+    PathUtil& PathUtil::operator=(const PathUtil& oth)
+    {
+        if (this != &oth)
+        {
+            _root      = oth._root;
+            _directory = oth._directory;
+            _file      = oth._file;
+            _extension = oth._extension;
+        }
+        return *this;
+    }
+
     PathUtil::PathUtil(const String& fileName)
     {
         construct(fileName);
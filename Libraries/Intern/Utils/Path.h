@@ -40,6 +40,8 @@ namespace Jam
 
         PathUtil(const PathUtil& oth);
 
+        PathUtil& operator=(const PathUtil& oth);
+
         /**
          * \brief Constructs the path with a file name.
          * \param fileName The file path that will be broken up into sections.
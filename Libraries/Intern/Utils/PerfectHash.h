@@ -0,0 +1,191 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+#include <cstdint>
+#include "Utils/Exception.h"
+#include "Utils/String.h"
+
+namespace Jam
+{
+    /**
+     * \brief Fixed capacity hash table over a known set of words.
+     *
+     * Building searches for a seed that gives every word its own slot,
+     * so a lookup is one hash and one compare. The build is constexpr,
+     * which lets static tables like the scanner keywords be laid out at
+     * compile time. A table that cannot be placed fails to compile.
+     *
+     * Keys are views and are not copied, so they must outlive the table.
+     *
+     * \tparam Value The mapped type. It must be default constructible.
+     * \tparam Size The number of slots. It must be a power of two, and
+     * about four times the number of keys keeps the seed search short.
+     */
+    template <typename Value, size_t Size>
+    class PerfectHash
+    {
+    public:
+        static_assert(Size > 0 && (Size & (Size - 1)) == 0,
+                      "the slot count must be a power of two");
+
+        static constexpr uint32_t MaxSeed = 0x4000;
+
+        struct Entry
+        {
+            StringView key{};
+            Value      value{};
+        };
+
+    private:
+        static constexpr size_t Mask = Size - 1;
+
+        Entry    _slots[Size]{};
+        uint32_t _seed{0};
+        size_t   _size{0};
+
+        static constexpr uint32_t hash(const StringView& key, const uint32_t seed)
+        {
+            uint32_t h = seed ^ (uint32_t)key.size() * 0x9E3779B1u;
+            for (const char ch : key)
+            {
+                h ^= (uint8_t)ch;
+                h *= 0x01000193u;
+            }
+            h ^= h >> 16;
+            h *= 0x85EBCA6Bu;
+            h ^= h >> 13;
+            return h;
+        }
+
+        template <typename T, typename KeyFn, typename ValueFn>
+        constexpr bool place(const T*       items,
+                             const size_t   count,
+                             const KeyFn&   key,
+                             const ValueFn& value,
+                             const uint32_t seed)
+        {
+            clear();
+            for (size_t i = 0; i < count; ++i)
+            {
+                const StringView k = key(items[i]);
+                if (k.empty())
+                    continue;
+
+                Entry& slot = _slots[hash(k, seed) & Mask];
+                if (slot.key.empty())
+                    ++_size;
+                else if (slot.key != k)
+                    return false;
+
+                // a repeated key replaces the earlier value
+                slot.key   = k;
+                slot.value = value(items[i]);
+            }
+            _seed = seed;
+            return true;
+        }
+
+    public:
+        constexpr PerfectHash() = default;
+
+        template <typename T, typename KeyFn, typename ValueFn>
+        constexpr PerfectHash(const T*       items,
+                              const size_t   count,
+                              const KeyFn&   key,
+                              const ValueFn& value)
+        {
+            if (!build(items, count, key, value))
+                throw Exception("failed to find a perfect hash seed");
+        }
+
+        /**
+         * \brief Replaces the contents with count items.
+         *
+         * \param key Returns the StringView key for an item. Empty keys are skipped.
+         * \param value Returns the Value for an item.
+         * \return false if no seed below MaxSeed separates the keys. The
+         * table is left empty in that case.
+         */
+        template <typename T, typename KeyFn, typename ValueFn>
+        constexpr bool build(const T*       items,
+                             const size_t   count,
+                             const KeyFn&   key,
+                             const ValueFn& value)
+        {
+            if (items != nullptr && count <= Size)
+            {
+                for (uint32_t seed = 1; seed < MaxSeed; ++seed)
+                {
+                    if (place(items, count, key, value, seed))
+                        return true;
+                }
+            }
+            clear();
+            return false;
+        }
+
+        constexpr bool build(const Entry* entries, const size_t count)
+        {
+            return build(
+                entries,
+                count,
+                [](const Entry& e) { return e.key; },
+                [](const Entry& e) { return e.value; });
+        }
+
+        constexpr bool find(const StringView& key, Value& dest) const
+        {
+            if (const Entry& slot = _slots[hash(key, _seed) & Mask];
+                !key.empty() && slot.key == key)
+            {
+                dest = slot.value;
+                return true;
+            }
+            return false;
+        }
+
+        constexpr bool contains(const StringView& key) const
+        {
+            Value unused{};
+            return find(key, unused);
+        }
+
+        constexpr void clear()
+        {
+            for (Entry& slot : _slots)
+                slot = Entry{};
+            _size = 0;
+            _seed = 0;
+        }
+
+        constexpr size_t size() const
+        {
+            return _size;
+        }
+
+        constexpr bool empty() const
+        {
+            return _size == 0;
+        }
+    };
+
+}  // namespace Jam
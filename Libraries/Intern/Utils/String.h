@@ -25,12 +25,14 @@
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
 namespace Jam
 {
     using String      = std::string;
+    using StringView  = std::string_view;
     using StringDeque = std::deque<std::string>;
     using StringArray = std::vector<std::string>;
     using StringMap   = std::unordered_map<std::string, std::string>;
@@ -6,13 +6,17 @@ namespace Jam::Xml
     class Node;
     class Attribute;
     class File;
+    class Reader;
+    class Writer;
 
 }  // namespace Jam::Xml
 
 namespace Jam
 {
-    using XmlNode = Xml::Node;
-    using XmlFile = Xml::File;
+    using XmlNode   = Xml::Node;
+    using XmlFile   = Xml::File;
+    using XmlReader = Xml::Reader;
+    using XmlWriter = Xml::Writer;
 
 
     using XmlPtr = ScopePtr<Xml::Node*>;
@@ -0,0 +1,547 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Xml/Document.h"
+#include "Utils/Char.h"
+#include "Xml/Entities.h"
+#include "Xml/Scanner.h"
+#include "Xml/Token.h"
+#include "Xml/Writer.h"
+
+namespace Jam::Xml
+{
+    namespace
+    {
+        void writeElement(Writer& out, const Element* element)
+        {
+            out.beginElement(element->name());
+            for (auto it = element->attributeBegin(); it != element->attributeEnd(); ++it)
+                out.attribute(it->name->text, it->value);
+
+            if (element->hasText())
+                out.text(element->text());
+
+            for (const Element* child = element->firstChild(); child; child = child->next())
+                writeElement(out, child);
+
+            out.endElement();
+        }
+
+    }  // namespace
+
+    Element* Element::firstChildOf(const int64_t tag) const
+    {
+        for (Element* child = _first; child; child = child->_next)
+        {
+            if (child->isTypeOf(tag))
+                return child;
+        }
+        return nullptr;
+    }
+
+    Element* Element::firstChildOf(const StringView& tag) const
+    {
+        for (Element* child = _first; child; child = child->_next)
+        {
+            if (child->isTypeOf(tag))
+                return child;
+        }
+        return nullptr;
+    }
+
+    Element* Element::nextSiblingOf(const int64_t tag) const
+    {
+        for (Element* sibling = _next; sibling; sibling = sibling->_next)
+        {
+            if (sibling->isTypeOf(tag))
+                return sibling;
+        }
+        return nullptr;
+    }
+
+    Element* Element::nextSiblingOf(const StringView& tag) const
+    {
+        for (Element* sibling = _next; sibling; sibling = sibling->_next)
+        {
+            if (sibling->isTypeOf(tag))
+                return sibling;
+        }
+        return nullptr;
+    }
+
+    const ElementAttribute* Element::find(const StringView& name) const
+    {
+        for (uint32_t i = 0; i < _attributeCount; ++i)
+        {
+            if (_attributes[i].name->text == name)
+                return &_attributes[i];
+        }
+        return nullptr;
+    }
+
+    const ElementAttribute* Element::find(const ElementName* name) const
+    {
+        for (uint32_t i = 0; i < _attributeCount; ++i)
+        {
+            if (_attributes[i].name == name)
+                return &_attributes[i];
+        }
+        return nullptr;
+    }
+
+    StringView Element::attribute(const StringView& name, const StringView& def) const
+    {
+        if (const ElementAttribute* attr = find(name))
+            return attr->value;
+        return def;
+    }
+
+    int64_t Element::integer(const StringView& name, const int64_t def) const
+    {
+        int64_t v = def;
+        if (const ElementAttribute* attr = find(name))
+            Char::fromChars(attr->value, v);
+        return v;
+    }
+
+    float Element::float32(const StringView& name, const float def) const
+    {
+        float v = def;
+        if (const ElementAttribute* attr = find(name))
+            Char::fromChars(attr->value, v);
+        return v;
+    }
+
+    double Element::float64(const StringView& name, const double def) const
+    {
+        double v = def;
+        if (const ElementAttribute* attr = find(name))
+            Char::fromChars(attr->value, v);
+        return v;
+    }
+
+    Document::Document()
+    {
+        _scanner = new Scanner();
+    }
+
+    Document::Document(const TypeFilter* filter, const size_t filterSize)
+    {
+        _scanner = new Scanner();
+        applyFilter(filter, filterSize);
+    }
+
+    Document::~Document()
+    {
+        delete _scanner;
+        _scanner = nullptr;
+    }
+
+    void Document::applyFilter(const TypeFilter* filter, const size_t filterSize)
+    {
+        makeTypeFilter(_filter, filter, filterSize);
+    }
+
+    void Document::clear()
+    {
+        _root = nullptr;
+        _stack.clear();
+        _scratch.clear();
+        _names.clear();
+        _ids.clear();
+        _arena.clear();
+    }
+
+    Element* Document::root(const int64_t code) const
+    {
+        return _root ? _root->firstChildOf(code) : nullptr;
+    }
+
+    Element* Document::root(const StringView& name) const
+    {
+        return _root ? _root->firstChildOf(name) : nullptr;
+    }
+
+    const ElementName* Document::name(const StringView& text) const
+    {
+        for (const ElementName* name : _names)
+        {
+            if (name->text == text)
+                return name;
+        }
+        return nullptr;
+    }
+
+    void Document::errorMessageImpl(String& dest, const String& message)
+    {
+        OutputStringStream oss;
+        oss << message << std::endl;
+
+        for (size_t i = _stack.size(); i > 1; --i)
+            oss << _stack[i - 1]->name() << std::endl;
+
+        dest = oss.str();
+    }
+
+    const ElementName* Document::intern(const size_t id)
+    {
+        // the scanner saves each distinct identifier once, so its
+        // string index already identifies the name
+        if (id >= _ids.size())
+            _ids.resize(id + 1, nullptr);
+
+        const ElementName*& name = _ids[id];
+        if (!name)
+        {
+            ElementName* created = _arena.construct<ElementName>();
+            created->text        = _arena.copy(_scanner->string(id));
+
+            if (!_filter.empty())
+                created->accepted = _filter.find(created->text, created->code);
+
+            _names.push_back(created);
+            name = created;
+        }
+        return name;
+    }
+
+    StringView Document::decode(const StringView& value)
+    {
+        if (!hasEntities(value))
+            return _arena.copy(value);
+
+        _decoded.clear();
+        unescape(_decoded, value);
+        return _arena.copy(_decoded);
+    }
+
+    void Document::createTag(const ElementName* name)
+    {
+        Element* element = _arena.construct<Element>();
+        element->_name   = name;
+        _stack.push_back(element);
+    }
+
+    Element& Document::top()
+    {
+        if (_stack.empty())
+            error("empty stack");
+        return *_stack.back();
+    }
+
+    void Document::closeAttributes()
+    {
+        if (!_scratch.empty())
+        {
+            Element& element = top();
+
+            const auto attributes = _arena.allocateArray<ElementAttribute>(_scratch.size());
+            for (size_t i = 0; i < _scratch.size(); ++i)
+                attributes[i] = _scratch[i];
+
+            element._attributes     = attributes;
+            element._attributeCount = (uint32_t)_scratch.size();
+            _scratch.clear();
+        }
+    }
+
+    void Document::reduceRule()
+    {
+        if (_stack.size() > 1)
+        {
+            Element* b = _stack.back();
+            _stack.pop_back();
+
+            // elements outside the filter are left unlinked
+            // along with everything below them
+            if (b->_name && b->_name->accepted)
+            {
+                Element* a = _stack.back();
+                b->_parent = a;
+
+                if (a->_last)
+                    a->_last->_next = b;
+                else
+                    a->_first = b;
+                a->_last = b;
+                ++a->_size;
+            }
+        }
+    }
+
+    void Document::dropRule()
+    {
+        if (_stack.size() > 1)
+            _stack.pop_back();
+    }
+
+    void Document::ruleAttributeList()
+    {
+        int8_t t0 = token(0).type();
+
+        if (t0 != TOK_EN_TAG && t0 != TOK_SLASH)
+        {
+            do
+            {
+                ruleAttribute();
+                t0 = token(0).type();
+
+                if (t0 == TOK_EOF)
+                    error("unexpected end of file");
+
+            } while (t0 != TOK_EN_TAG && t0 != TOK_SLASH);
+        }
+    }
+
+    void Document::ruleAttribute()
+    {
+        const int8_t t0 = token(0).type();
+        const int8_t t1 = token(1).type();
+        const int8_t t2 = token(2).type();
+
+        if (t0 != TOK_IDENTIFIER)
+            error("expected an identifier");
+        if (t1 != TOK_EQUALS)
+            error("expected an equals sign");
+        if (t2 != TOK_STRING)
+            error("expected an equals sign");
+
+        const ElementName* key = intern(token(0).index());
+
+        for (const ElementAttribute& attr : _scratch)
+        {
+            if (attr.name == key)
+                error(String(top().name()), " duplicate attribute ", key->text);
+        }
+
+        _scratch.push_back({key, decode(_scanner->string(token(2).index()))});
+        advanceCursor(3);
+    }
+
+    void Document::ruleXmlRoot()
+    {
+        int8_t       t0 = token(0).type();
+        const int8_t t1 = token(1).type();
+        const int8_t t2 = token(2).type();
+
+        if (t0 != TOK_ST_TAG)
+            error("expected the '<' character");
+        if (t1 != TOK_QUESTION)
+            error("expected the '/' character");
+        if (t2 != TOK_KW_XML)
+            error("expected the xml keyword");
+
+        advanceCursor(3);
+        t0 = token(0).type();
+
+        while (t0 != TOK_QUESTION)
+        {
+            ruleAttribute();
+            t0 = token(0).type();
+            if (t0 == TOK_EOF)
+                error("unexpected end of file");
+        }
+
+        // the header attributes are not kept
+        _scratch.clear();
+
+        advanceCursor();
+        t0 = token(0).type();
+        if (t0 != TOK_EN_TAG)
+            error("unexpected token ", Char::toHexString((uint8_t)t0));
+        advanceCursor();
+    }
+
+    void Document::ruleStartTag()
+    {
+        const Token& t0 = token(0);
+        const Token& t1 = token(1);
+
+        if (t0.type() != TOK_ST_TAG)
+            error("expected the < character");
+        if (t1.type() != TOK_IDENTIFIER)
+            error("expected a tag identifier");
+
+        const ElementName* name = intern(t1.index());
+        if (name->text.empty())
+            error("empty tag name");
+
+        advanceCursor(2);
+
+        createTag(name);
+
+        ruleAttributeList();
+        closeAttributes();
+
+        // Test exit state from the attribute list call
+        // > means leave element on the stack
+        // / means remove the element from the stack
+
+        const int8_t et0 = token(0).type();
+
+        if (et0 == TOK_SLASH)
+        {
+            const int8_t et1 = token(1).type();
+            if (et1 != TOK_EN_TAG)
+                error("expected the '>' character ");
+
+            reduceRule();
+            advanceCursor(2);
+        }
+        else if (et0 != TOK_EN_TAG)
+            error("expected the '>' character ");
+        else
+            advanceCursor();
+    }
+
+    void Document::ruleContent()
+    {
+        const Token& t0 = token(0);
+        if (t0.type() != TOK_TEXT)
+            error("expected content text");
+
+        const StringView content = ((Scanner*)_scanner)->code(t0.index());
+        if (content.empty())
+            error("unexpected empty content token");
+
+        top()._text = decode(content);
+
+        advanceCursor();
+    }
+
+    void Document::ruleEndTag()
+    {
+        // '<' '/'
+        const int8_t t0 = token(0).type();
+        const int8_t t1 = token(1).type();
+        const int8_t t2 = token(2).type();
+        const int8_t t3 = token(3).type();
+
+        if (t0 != TOK_ST_TAG)
+            error("expected the '<' character");
+        if (t1 != TOK_SLASH)
+            error("expected the '/' character");
+        if (t2 != TOK_IDENTIFIER)
+            error("expected a tag identifier");
+        if (t3 != TOK_EN_TAG)
+            error("expected the '>' character");
+
+        // names are interned, so the addresses match
+        // only if the text does
+        const ElementName* identifier = intern(token(2).index());
+
+        if (identifier != top()._name)
+        {
+            error("closing tag mis-match between '",
+                  top().name(),
+                  '\'',
+                  " and '",
+                  identifier->text,
+                  '\'');
+        }
+
+        advanceCursor(4);
+        reduceRule();
+    }
+
+    void Document::ruleObject()
+    {
+        const int8_t t0 = token(0).type();
+        const int8_t t1 = token(1).type();
+        const int8_t t2 = token(2).type();
+
+        if (t0 == TOK_ST_TAG && t1 == TOK_IDENTIFIER)
+            ruleStartTag();
+        else if (t0 == TOK_ST_TAG && t1 == TOK_SLASH && t2 == TOK_IDENTIFIER)
+            ruleEndTag();
+        else
+            ruleContent();
+    }
+
+    void Document::ruleObjectList()
+    {
+        const int8_t t0 = token(0).type();
+        const int8_t t1 = token(1).type();
+
+        if (t1 == TOK_QUESTION)
+        {
+            createTag(nullptr);
+
+            ruleXmlRoot();
+            dropRule();
+        }
+        else if (t0 == TOK_ST_TAG || t0 == TOK_TEXT)
+            ruleObject();
+        else
+            error("unknown token parsed 0x", Char::toHexString((uint8_t)t0));
+    }
+
+    void Document::parseImpl(const StringView source)
+    {
+        clear();
+
+        // a new scanner restarts the string indices
+        // that intern uses
+        delete _scanner;
+        _scanner = new Scanner();
+
+        resetTokens();
+        _scanner->attach(source, PathUtil(_file));
+
+        _root = _arena.construct<Element>();
+        _stack.push_back(_root);
+
+        while (tokenType(0) != TOK_EOF)
+        {
+            const int32_t op = _cursor;
+            ruleObjectList();
+
+            // if the cursor did not
+            // advance force it to.
+            if (op == _cursor)
+                advanceCursor();
+        }
+
+        _stack.clear();
+    }
+
+    void Document::writeImpl(OStream& output, const int format)
+    {
+        if (_root && _root->firstChild())
+        {
+            int32_t indent = 1;
+            if (format & Indent2)
+                indent = 2;
+            else if (format & Indent4)
+                indent = 4;
+
+            Writer writer;
+            writer.setMinify((format & Minify) != 0);
+            writer.setIndent(indent);
+            writer.setShowXmlHeader(false);
+
+            writer.begin(output);
+            writeElement(writer, _root->firstChild());
+            writer.end();
+        }
+    }
+
+}  // namespace Jam::Xml
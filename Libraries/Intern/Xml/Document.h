@@ -0,0 +1,308 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+#include <vector>
+#include "Utils/Arena.h"
+#include "Utils/ParserBase/ParserBase.h"
+#include "Utils/String.h"
+#include "Xml/TypeFilter.h"
+
+namespace Jam::Xml
+{
+    /**
+     * \brief A tag or attribute name.
+     *
+     * Each distinct name is stored once per document, so two names
+     * are equal only if they have the same address.
+     */
+    struct ElementName
+    {
+        StringView text{};
+        int64_t    code{-1};
+        bool       accepted{true};
+    };
+
+    struct ElementAttribute
+    {
+        const ElementName* name{nullptr};
+        StringView         value{};
+    };
+
+    /**
+     * \brief Read only element of a Document.
+     *
+     * Elements, their attribute arrays, names and text all live in the
+     * arena of the owning Document and are valid until it is cleared,
+     * parses again or is destroyed. Attributes are kept as a small flat
+     * array in source order, so lookups compare names instead of hashing.
+     */
+    class Element
+    {
+    private:
+        friend class Document;
+
+        const ElementName*      _name{nullptr};
+        Element*                _parent{nullptr};
+        Element*                _first{nullptr};
+        Element*                _last{nullptr};
+        Element*                _next{nullptr};
+        const ElementAttribute* _attributes{nullptr};
+        StringView              _text{};
+        uint32_t                _attributeCount{0};
+        uint32_t                _size{0};
+
+    public:
+        StringView name() const;
+
+        int64_t typeCode() const;
+
+        bool isTypeOf(int64_t type) const;
+
+        bool isTypeOf(const StringView& tag) const;
+
+        Element* parent() const;
+
+        Element* firstChild() const;
+
+        Element* next() const;
+
+        size_t size() const;
+
+        bool hasChildren() const;
+
+        StringView text() const;
+
+        bool hasText() const;
+
+        bool hasAttributes() const;
+
+        const ElementAttribute* attributeBegin() const;
+
+        const ElementAttribute* attributeEnd() const;
+
+        Element* firstChildOf(int64_t tag) const;
+
+        Element* firstChildOf(const StringView& tag) const;
+
+        Element* nextSiblingOf(int64_t tag) const;
+
+        Element* nextSiblingOf(const StringView& tag) const;
+
+        const ElementAttribute* find(const StringView& name) const;
+
+        // Address compare only, see Document::name.
+        const ElementAttribute* find(const ElementName* name) const;
+
+        StringView attribute(const StringView& name, const StringView& def = {}) const;
+
+        int64_t integer(const StringView& name, int64_t def = -1) const;
+
+        float float32(const StringView& name, float def = 0.f) const;
+
+        double float64(const StringView& name, double def = 0.0) const;
+    };
+
+    /**
+     * \brief Compact alternative to Xml::File.
+     *
+     * It reads the same grammar, but builds the tree in one arena
+     * instead of allocating a Node, two strings, a map and a vector per
+     * element. A parse costs a few large blocks, and destroying the
+     * tree releases those blocks without visiting the elements.
+     *
+     * Differences from File:
+     * - Each parse replaces the previous tree.
+     * - Text is only kept on the element that holds it. No _text_node
+     *   children are created.
+     * - Elements cannot be edited after the parse.
+     */
+    class Document final : public ParserBase
+    {
+    private:
+        Arena                           _arena;
+        Element*                        _root{nullptr};
+        std::vector<Element*>           _stack;
+        std::vector<ElementAttribute>   _scratch;
+        std::vector<const ElementName*> _names;
+        std::vector<const ElementName*> _ids;
+        TypeFilterMap                   _filter;
+        String                          _decoded;
+
+        void parseImpl(StringView source) override;
+
+        void writeImpl(OStream& output, int format) override;
+
+        void errorMessageImpl(String& dest, const String& message) override;
+
+        void ruleAttributeList();
+
+        void ruleAttribute();
+
+        void ruleObject();
+
+        void ruleStartTag();
+
+        void ruleContent();
+
+        void ruleEndTag();
+
+        void ruleXmlRoot();
+
+        void ruleObjectList();
+
+        const ElementName* intern(size_t id);
+
+        StringView decode(const StringView& value);
+
+        void createTag(const ElementName* name);
+
+        void closeAttributes();
+
+        void reduceRule();
+
+        void dropRule();
+
+        Element& top();
+
+    public:
+        Document();
+
+        /**
+         * \brief Construct the parser with an element type filter.
+         * \param filter A constant array of tag-name to tag-id structures.
+         * \param filterSize The total size of the constant array.
+         */
+        Document(const TypeFilter* filter, size_t filterSize);
+
+        ~Document() override;
+
+        /**
+         * \brief Applies an element type filter to this parser.
+         *
+         * Only elements whose names are in the filter are kept, and
+         * each kept element is tagged with its code during the parse.
+         */
+        void applyFilter(const TypeFilter* filter, size_t filterSize);
+
+        // Releases the tree but keeps the first arena block for reuse.
+        void clear();
+
+        /**
+         * \brief The unnamed element that holds the top level elements.
+         */
+        Element* tree() const;
+
+        Element* root(int64_t code) const;
+
+        Element* root(const StringView& name) const;
+
+        /**
+         * \brief Looks up a name that appeared in the last parse.
+         * \return The interned name or null. Pass it to Element::find
+         * to look attributes up by address.
+         */
+        const ElementName* name(const StringView& text) const;
+
+        const Arena& arena() const;
+    };
+
+    inline StringView Element::name() const
+    {
+        return _name ? _name->text : StringView();
+    }
+
+    inline int64_t Element::typeCode() const
+    {
+        return _name ? _name->code : -1;
+    }
+
+    inline bool Element::isTypeOf(const int64_t type) const
+    {
+        return typeCode() == type;
+    }
+
+    inline bool Element::isTypeOf(const StringView& tag) const
+    {
+        return name() == tag;
+    }
+
+    inline Element* Element::parent() const
+    {
+        return _parent;
+    }
+
+    inline Element* Element::firstChild() const
+    {
+        return _first;
+    }
+
+    inline Element* Element::next() const
+    {
+        return _next;
+    }
+
+    inline size_t Element::size() const
+    {
+        return _size;
+    }
+
+    inline bool Element::hasChildren() const
+    {
+        return _first != nullptr;
+    }
+
+    inline StringView Element::text() const
+    {
+        return _text;
+    }
+
+    inline bool Element::hasText() const
+    {
+        return !_text.empty();
+    }
+
+    inline bool Element::hasAttributes() const
+    {
+        return _attributeCount > 0;
+    }
+
+    inline const ElementAttribute* Element::attributeBegin() const
+    {
+        return _attributes;
+    }
+
+    inline const ElementAttribute* Element::attributeEnd() const
+    {
+        return _attributes + _attributeCount;
+    }
+
+    inline Element* Document::tree() const
+    {
+        return _root;
+    }
+
+    inline const Arena& Document::arena() const
+    {
+        return _arena;
+    }
+
+}  // namespace Jam::Xml
@@ -0,0 +1,140 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Xml/Entities.h"
+#include "Utils/Char.h"
+
+namespace Jam::Xml
+{
+    namespace
+    {
+        const char* entityOf(const char ch, const bool attribute)
+        {
+            // clang-format off
+            switch (ch)
+            {
+            case '&':  return "&amp;";
+            case '<':  return "&lt;";
+            case '>':  return attribute ? "&gt;" : nullptr;
+            case '"':  return attribute ? "&quot;" : nullptr;
+            case '\'': return attribute ? "&apos;" : nullptr;
+            default:   return nullptr;
+            }
+            // clang-format on
+        }
+
+        void appendUtf8(String& dest, const uint32_t cp)
+        {
+            if (cp < 0x80)
+                dest.push_back((char)cp);
+            else if (cp < 0x800)
+            {
+                dest.push_back((char)(0xC0 | (cp >> 6)));
+                dest.push_back((char)(0x80 | (cp & 0x3F)));
+            }
+            else if (cp < 0x10000)
+            {
+                dest.push_back((char)(0xE0 | (cp >> 12)));
+                dest.push_back((char)(0x80 | ((cp >> 6) & 0x3F)));
+                dest.push_back((char)(0x80 | (cp & 0x3F)));
+            }
+            else
+            {
+                dest.push_back((char)(0xF0 | (cp >> 18)));
+                dest.push_back((char)(0x80 | ((cp >> 12) & 0x3F)));
+                dest.push_back((char)(0x80 | ((cp >> 6) & 0x3F)));
+                dest.push_back((char)(0x80 | (cp & 0x3F)));
+            }
+        }
+
+        // Decodes the entity between '&' and ';' into dest.
+        bool decode(String& dest, const StringView& name)
+        {
+            if (name == "amp")
+                dest.push_back('&');
+            else if (name == "lt")
+                dest.push_back('<');
+            else if (name == "gt")
+                dest.push_back('>');
+            else if (name == "quot")
+                dest.push_back('"');
+            else if (name == "apos")
+                dest.push_back('\'');
+            else if (name.size() > 1 && name[0] == '#')
+            {
+                const bool hex    = name[1] == 'x' || name[1] == 'X';
+                const auto digits = name.substr(hex ? 2 : 1);
+
+                int64_t cp = 0;
+                if (digits.empty() ||
+                    Char::fromChars(digits, cp, hex ? 16 : 10) != digits.size() ||
+                    cp <= 0 || cp > 0x10FFFF)
+                    return false;
+                appendUtf8(dest, (uint32_t)cp);
+            }
+            else
+                return false;
+            return true;
+        }
+
+    }  // namespace
+
+    void escape(String& dest, const StringView& value, const bool attribute)
+    {
+        size_t first = 0;
+        for (size_t i = 0; i < value.size(); ++i)
+        {
+            if (const char* entity = entityOf(value[i], attribute))
+            {
+                dest.append(value.data() + first, i - first);
+                dest.append(entity);
+                first = i + 1;
+            }
+        }
+        dest.append(value.data() + first, value.size() - first);
+    }
+
+    void unescape(String& dest, const StringView& value)
+    {
+        size_t i = 0;
+        while (i < value.size())
+        {
+            const size_t amp = value.find('&', i);
+            if (amp == StringView::npos)
+                break;
+
+            dest.append(value.data() + i, amp - i);
+
+            const size_t semi = value.find(';', amp + 1);
+            if (semi != StringView::npos &&
+                decode(dest, value.substr(amp + 1, semi - amp - 1)))
+                i = semi + 1;
+            else
+            {
+                dest.push_back('&');
+                i = amp + 1;
+            }
+        }
+        if (i < value.size())
+            dest.append(value.data() + i, value.size() - i);
+    }
+
+}  // namespace Jam::Xml
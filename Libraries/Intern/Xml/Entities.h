@@ -0,0 +1,47 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+#include "Utils/String.h"
+
+namespace Jam::Xml
+{
+    /**
+     * \brief Appends value to dest with the characters that would end
+     * or confuse a value replaced by entities.
+     *
+     * Text escapes & and <. Attributes also escape > and both quotes,
+     * since the scanner closes a string on either quote character.
+     */
+    extern void escape(String& dest, const StringView& value, bool attribute);
+
+    /**
+     * \brief Appends value to dest with the predefined and numeric
+     * character references decoded. Unknown entities are kept as is.
+     */
+    extern void unescape(String& dest, const StringView& value);
+
+    inline bool hasEntities(const StringView& value)
+    {
+        return value.find('&') != StringView::npos;
+    }
+
+}  // namespace Jam::Xml
@@ -21,6 +21,7 @@
 */
 #include "Xml/File.h"
 #include "Utils/Char.h"
+#include "Xml/Entities.h"
 #include "Xml/Node.h"
 #include "Xml/Scanner.h"
 #include "Xml/Token.h"
@@ -128,11 +129,11 @@ namespace Jam::Xml
             }
             else
             {
-                if (const auto it = _filter.find(b->name());
-                    it != _filter.end())
+                if (int64_t code;
+                    _filter.find(b->name(), code))
                 {
                     Node* a = _stack.top();
-                    b->setTypeCode(it->second);
+                    b->setTypeCode(code);
                     a->addChild(b);
                 }
                 else
@@ -191,7 +192,11 @@ namespace Jam::Xml
             error(node.name(), " duplicate attribute ", identifier);
 
         String value;
-        _scanner->string(value, token(2).index());
+        const StringView raw = _scanner->string(token(2).index());
+        if (hasEntities(raw))
+            unescape(value, raw);
+        else
+            value.assign(raw.data(), raw.size());
 
         node.insert(identifier, value);
         advanceCursor(3);
@@ -284,6 +289,13 @@ namespace Jam::Xml
         if (content.empty())
             error("unexpected empty content token");
 
+        if (hasEntities(content))
+        {
+            String decoded;
+            unescape(decoded, content);
+            content.swap(decoded);
+        }
+
         top().text(content);
 
         Node* node = createTag("_text_node");
@@ -365,22 +377,18 @@ namespace Jam::Xml
             error("unknown token parsed 0x", Char::toHexString((uint8_t)t0));
     }
 
-    void File::parseImpl(IStream& input)
+    void File::parseImpl(const StringView source)
     {
         // make sure the token cursor is at zero
-        // initially and attach the input stream
+        // initially and attach the source text
         // to the scanner
-        _cursor = 0;
-        _scanner->attach(&input, PathUtil(_file));
+        resetTokens();
+        _scanner->attach(source, PathUtil(_file));
 
         _stack.push(_root);
 
-        while (_cursor <= (int32_t)_tokens.size())
+        while (tokenType(0) != TOK_EOF)
         {
-            if (const int8_t tok = token(0).type();
-                tok == TOK_EOF)
-                break;
-
             const int32_t op = _cursor;
             ruleObjectList();
 
@@ -430,11 +438,8 @@ namespace Jam::Xml
 
         if (!ret.empty())
         {
-            StringStream ss;
-            ss << ret;
-
             File fp(filter, filterSize);
-            fp.read(ss);
+            fp.readText(ret);
 
             return fp.detachRoot();
         }
@@ -128,7 +128,7 @@ namespace Jam::Xml
          * \brief Implements the actual parse loop.
          * \param input The input stream to read from.
          */
-        void parseImpl(IStream& input) override;
+        void parseImpl(StringView source) override;
 
         /**
          * \brief Implements a write method to write the node tree to file.
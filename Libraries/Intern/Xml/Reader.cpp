@@ -0,0 +1,396 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Xml/Reader.h"
+#include "Utils/Char.h"
+#include "Xml/Entities.h"
+#include "Xml/Scanner.h"
+#include "Xml/Token.h"
+
+namespace Jam::Xml
+{
+    Reader::Reader()
+    {
+        _scanner = new Scanner();
+    }
+
+    Reader::Reader(const TypeFilter* filter, const size_t filterSize)
+    {
+        _scanner = new Scanner();
+        applyFilter(filter, filterSize);
+    }
+
+    Reader::~Reader()
+    {
+        delete _scanner;
+        _scanner = nullptr;
+    }
+
+    void Reader::applyFilter(const TypeFilter* filter, const size_t filterSize)
+    {
+        makeTypeFilter(_filter, filter, filterSize);
+    }
+
+    void Reader::parseImpl(const StringView source)
+    {
+        // nothing is read here, next pulls
+        // the events out of the source
+        delete _scanner;
+
+        const auto scanner = new Scanner();
+        scanner->setTransient(true);
+        _scanner = scanner;
+
+        resetTokens();
+        _scanner->attach(source, PathUtil(_file));
+
+        _stack.clear();
+        _attributes.clear();
+        _event        = EventNone;
+        _name         = {};
+        _value        = {};
+        _code         = -1;
+        _depth        = 0;
+        _hidden       = 0;
+        _attribute    = 0;
+        _closePending = false;
+    }
+
+    void Reader::writeImpl(OStream&, int)
+    {
+        throw Exception("an Xml::Reader has no tree to write");
+    }
+
+    void Reader::errorMessageImpl(String& dest, const String& message)
+    {
+        OutputStringStream oss;
+        oss << message << std::endl;
+
+        for (size_t i = _stack.size(); i > 0; --i)
+            oss << _stack[i - 1].name << std::endl;
+
+        dest = oss.str();
+    }
+
+    StringView Reader::view(const int32_t offs)
+    {
+        return ((Scanner*)_scanner)->view(token(offs).index());
+    }
+
+    bool Reader::next()
+    {
+        while (step())
+        {
+            if (_visible)
+                return true;
+        }
+        return false;
+    }
+
+    void Reader::dispatch(ReaderHandler& handler)
+    {
+        while (next())
+        {
+            switch (_event)
+            {
+            case EventStartElement:
+                handler.startElement(*this);
+                break;
+            case EventAttribute:
+                handler.attribute(_name, _value);
+                break;
+            case EventText:
+                handler.text(_value);
+                break;
+            case EventEndElement:
+                handler.endElement(*this);
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    void Reader::skip()
+    {
+        if (_event != EventStartElement)
+            return;
+
+        const size_t depth = _depth;
+        while (step())
+        {
+            if (_event == EventEndElement && _depth == depth)
+                break;
+        }
+    }
+
+    StringView Reader::decode(const StringView& value)
+    {
+        if (!hasEntities(value))
+            return value;
+
+        // a deque keeps the earlier strings in place as it grows
+        if (_decodedUsed >= _decoded.size())
+            _decoded.emplace_back();
+
+        String& dest = _decoded[_decodedUsed++];
+        dest.clear();
+        unescape(dest, value);
+        return dest;
+    }
+
+    bool Reader::step()
+    {
+        if (_attribute < _attributes.size())
+        {
+            const Pair& attr = _attributes[_attribute++];
+
+            _event   = EventAttribute;
+            _name    = attr.first;
+            _value   = attr.second;
+            _visible = _hidden == 0;
+            return true;
+        }
+
+        if (_closePending)
+        {
+            _closePending = false;
+            closeElement();
+            return true;
+        }
+
+        for (;;)
+        {
+            const int8_t t0 = tokenType(0);
+
+            if (t0 == TOK_EOF)
+            {
+                if (!_stack.empty())
+                    error("unexpected end of file");
+
+                _event   = EventNone;
+                _visible = false;
+                return false;
+            }
+
+            if (t0 == TOK_TEXT)
+            {
+                _event = EventText;
+                _value = view(0);
+                if (hasEntities(_value))
+                {
+                    _text.clear();
+                    unescape(_text, _value);
+                    _value = _text;
+                }
+                _name  = _stack.empty() ? StringView() : _stack.back().name;
+                _code  = _stack.empty() ? -1 : _stack.back().code;
+                _depth = _stack.size();
+
+                _visible = _hidden == 0;
+                advanceCursor();
+                return true;
+            }
+
+            if (t0 != TOK_ST_TAG)
+                error("unknown token parsed 0x", Char::toHexString((uint8_t)t0));
+
+            const int8_t t1 = tokenType(1);
+            if (t1 == TOK_QUESTION)
+                ruleXmlRoot();
+            else if (t1 == TOK_IDENTIFIER)
+            {
+                ruleStartTag();
+                return true;
+            }
+            else if (t1 == TOK_SLASH)
+            {
+                ruleEndTag();
+                return true;
+            }
+            else
+                error("expected a tag identifier");
+        }
+    }
+
+    void Reader::ruleXmlRoot()
+    {
+        if (tokenType(2) != TOK_KW_XML)
+            error("expected the xml keyword");
+        advanceCursor(3);
+
+        // the header attributes are not reported
+        int8_t t0 = tokenType(0);
+        while (t0 != TOK_QUESTION)
+        {
+            if (t0 != TOK_IDENTIFIER || tokenType(1) != TOK_EQUALS || tokenType(2) != TOK_STRING)
+                error("expected an attribute");
+
+            advanceCursor(3);
+            t0 = tokenType(0);
+        }
+
+        if (tokenType(1) != TOK_EN_TAG)
+            error("expected the '>' character");
+        advanceCursor(2);
+    }
+
+    void Reader::ruleStartTag()
+    {
+        const StringView name = view(1);
+        if (name.empty())
+            error("empty tag name");
+        advanceCursor(2);
+
+        _attributes.clear();
+        _attribute   = 0;
+        _decodedUsed = 0;
+
+        int8_t t0 = tokenType(0);
+        while (t0 != TOK_EN_TAG && t0 != TOK_SLASH)
+        {
+            if (t0 == TOK_EOF)
+                error("unexpected end of file");
+            if (t0 != TOK_IDENTIFIER)
+                error("expected an identifier");
+            if (tokenType(1) != TOK_EQUALS)
+                error("expected an equals sign");
+            if (tokenType(2) != TOK_STRING)
+                error("expected a string");
+
+            const StringView key = view(0);
+            for (const Pair& attr : _attributes)
+            {
+                if (attr.first == key)
+                    error(String(name), " duplicate attribute ", key);
+            }
+
+            _attributes.emplace_back(key, decode(view(2)));
+            advanceCursor(3);
+            t0 = tokenType(0);
+        }
+
+        if (t0 == TOK_SLASH)
+        {
+            if (tokenType(1) != TOK_EN_TAG)
+                error("expected the '>' character ");
+
+            _closePending = true;
+            advanceCursor(2);
+        }
+        else
+            advanceCursor();
+
+        int64_t code     = -1;
+        bool    accepted = true;
+        if (!_filter.empty())
+            accepted = _filter.find(name, code);
+
+        const bool hidden = _hidden > 0 || !accepted;
+        if (hidden)
+            ++_hidden;
+
+        _stack.push_back({name, code, hidden});
+
+        _event   = EventStartElement;
+        _name    = name;
+        _value   = {};
+        _code    = code;
+        _depth   = _stack.size();
+        _visible = !hidden;
+    }
+
+    void Reader::ruleEndTag()
+    {
+        if (tokenType(2) != TOK_IDENTIFIER)
+            error("expected a tag identifier");
+        if (tokenType(3) != TOK_EN_TAG)
+            error("expected the '>' character");
+
+        const StringView identifier = view(2);
+        if (_stack.empty())
+            error("closing tag '", identifier, "' without an opening tag");
+
+        if (identifier != _stack.back().name)
+        {
+            error("closing tag mis-match between '",
+                  _stack.back().name,
+                  '\'',
+                  " and '",
+                  identifier,
+                  '\'');
+        }
+
+        advanceCursor(4);
+        closeElement();
+    }
+
+    void Reader::closeElement()
+    {
+        const Open open = _stack.back();
+
+        _event   = EventEndElement;
+        _name    = open.name;
+        _value   = {};
+        _code    = open.code;
+        _depth   = _stack.size();
+        _visible = !open.hidden;
+
+        _stack.pop_back();
+        if (open.hidden)
+            --_hidden;
+    }
+
+    StringView Reader::attribute(const StringView& name, const StringView& def) const
+    {
+        for (const Pair& attr : _attributes)
+        {
+            if (attr.first == name)
+                return attr.second;
+        }
+        return def;
+    }
+
+    int64_t Reader::integer(const StringView& name, const int64_t def) const
+    {
+        int64_t v = def;
+        if (const StringView val = attribute(name); !val.empty())
+            Char::fromChars(val, v);
+        return v;
+    }
+
+    float Reader::float32(const StringView& name, const float def) const
+    {
+        float v = def;
+        if (const StringView val = attribute(name); !val.empty())
+            Char::fromChars(val, v);
+        return v;
+    }
+
+    double Reader::float64(const StringView& name, const double def) const
+    {
+        double v = def;
+        if (const StringView val = attribute(name); !val.empty())
+            Char::fromChars(val, v);
+        return v;
+    }
+
+}  // namespace Jam::Xml
@@ -0,0 +1,240 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+#include <deque>
+#include <vector>
+#include "Utils/ParserBase/ParserBase.h"
+#include "Utils/String.h"
+#include "Xml/TypeFilter.h"
+
+namespace Jam::Xml
+{
+    class Reader;
+
+    enum ReaderEvent
+    {
+        EventNone,
+        EventStartElement,
+        EventAttribute,
+        EventText,
+        EventEndElement,
+    };
+
+    /**
+     * \brief Receives the events of Reader::dispatch.
+     */
+    class ReaderHandler
+    {
+    public:
+        virtual ~ReaderHandler() = default;
+
+        // The attributes of the element can be read from the reader.
+        virtual void startElement(const Reader& /*reader*/)
+        {
+        }
+
+        virtual void attribute(const StringView& /*name*/, const StringView& /*value*/)
+        {
+        }
+
+        virtual void text(const StringView& /*text*/)
+        {
+        }
+
+        virtual void endElement(const Reader& /*reader*/)
+        {
+        }
+    };
+
+    /**
+     * \brief Streams the elements of an XML document without building
+     * a tree.
+     *
+     * After one of the read methods, each call to next moves to the
+     * following event. With a type filter, elements outside the filter
+     * are skipped along with their content, and code() is the filter
+     * code of the current element.
+     *
+     * Memory use is bounded by the depth of the document and the
+     * attribute count of one element. All names and values are views
+     * into the source, which must stay alive while reading. For readText
+     * that means past the call, unlike the other parsers. Values that
+     * hold entities are decoded into storage owned by the reader.
+     *
+     * \code{.cpp}
+     * Xml::Reader reader(filter, filterSize);
+     * reader.read(path);
+     * while (reader.next())
+     * {
+     *     if (reader.event() == Xml::EventStartElement &&
+     *         reader.isTypeOf(ItemTag))
+     *         use(reader.attribute("name"));
+     * }
+     * \endcode
+     */
+    class Reader final : public ParserBase
+    {
+    private:
+        struct Open
+        {
+            StringView name;
+            int64_t    code;
+            bool       hidden;
+        };
+
+        using Pair = std::pair<StringView, StringView>;
+
+        std::vector<Open>  _stack;
+        std::vector<Pair>  _attributes;
+        std::deque<String> _decoded;
+        size_t             _decodedUsed{0};
+        String             _text;
+        TypeFilterMap      _filter;
+        ReaderEvent        _event{EventNone};
+        StringView         _name{};
+        StringView         _value{};
+        int64_t            _code{-1};
+        size_t             _depth{0};
+        size_t             _hidden{0};
+        size_t             _attribute{0};
+        bool               _closePending{false};
+        bool               _visible{false};
+
+        void parseImpl(StringView source) override;
+
+        void writeImpl(OStream& output, int format) override;
+
+        void errorMessageImpl(String& dest, const String& message) override;
+
+        StringView view(int32_t offs);
+
+        StringView decode(const StringView& value);
+
+        bool step();
+
+        void ruleXmlRoot();
+
+        void ruleStartTag();
+
+        void ruleEndTag();
+
+        void closeElement();
+
+    public:
+        Reader();
+
+        /**
+         * \brief Construct the reader with an element type filter.
+         * \param filter A constant array of tag-name to tag-id structures.
+         * \param filterSize The total size of the constant array.
+         */
+        Reader(const TypeFilter* filter, size_t filterSize);
+
+        ~Reader() override;
+
+        void applyFilter(const TypeFilter* filter, size_t filterSize);
+
+        /**
+         * \brief Moves to the next event.
+         * \return false at the end of the document.
+         */
+        bool next();
+
+        /**
+         * \brief Reads every remaining event into handler.
+         */
+        void dispatch(ReaderHandler& handler);
+
+        /**
+         * \brief Moves past the end of the current element.
+         *
+         * Only meaningful on an EventStartElement. The current event
+         * is the matching EventEndElement afterward.
+         */
+        void skip();
+
+        ReaderEvent event() const;
+
+        /**
+         * \brief The element name, or the attribute name on an
+         * EventAttribute.
+         */
+        StringView name() const;
+
+        /**
+         * \brief The attribute value, or the text on an EventText.
+         */
+        StringView value() const;
+
+        // The filter code of the current element, or -1.
+        int64_t code() const;
+
+        bool isTypeOf(int64_t type) const;
+
+        // The number of open elements, counting the current one.
+        size_t depth() const;
+
+        /**
+         * \brief Looks up an attribute of the last started element.
+         *
+         * Attributes stay readable until the next EventStartElement.
+         */
+        StringView attribute(const StringView& name, const StringView& def = {}) const;
+
+        int64_t integer(const StringView& name, int64_t def = -1) const;
+
+        float float32(const StringView& name, float def = 0.f) const;
+
+        double float64(const StringView& name, double def = 0.0) const;
+    };
+
+    inline ReaderEvent Reader::event() const
+    {
+        return _event;
+    }
+
+    inline StringView Reader::name() const
+    {
+        return _name;
+    }
+
+    inline StringView Reader::value() const
+    {
+        return _value;
+    }
+
+    inline int64_t Reader::code() const
+    {
+        return _code;
+    }
+
+    inline bool Reader::isTypeOf(const int64_t type) const
+    {
+        return _code == type;
+    }
+
+    inline size_t Reader::depth() const
+    {
+        return _depth;
+    }
+
+}  // namespace Jam::Xml
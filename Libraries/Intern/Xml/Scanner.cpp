@@ -56,64 +56,92 @@ namespace Jam::Xml
             syntaxError("code index out of bounds");
     }
 
+    void Scanner::setTransient(const bool transient)
+    {
+        _transient = transient;
+    }
+
+    size_t Scanner::keep(const StringView& str)
+    {
+        if (!_transient)
+            return save(str);
+
+        const size_t idx            = _ringNext++;
+        _ring[idx & (RingSize - 1)] = str;
+        return idx;
+    }
+
+    StringView Scanner::view(const size_t& idx) const
+    {
+        if (_transient)
+            return _ring[idx & (RingSize - 1)];
+        return string(idx);
+    }
+
+    StringView Scanner::code(const size_t& idx)
+    {
+        if (idx >= _code.size())
+            syntaxError("code index out of bounds");
+        return _code[idx];
+    }
+
     void Scanner::scanString(Token& tok)
     {
-        int ch = _stream->get();
-        if (!isQuote(ch))
+        const int quote = get();
+        if (!isQuote(quote))
             syntaxError("expected the quote character '\"'");
 
-        String dest;
-        ch = _stream->get();
-        while (!isQuote(ch))
+        const char* first = cursor();
+        while (_cur < _end && !isQuote((uint8_t)*_cur))
         {
-            dest.push_back((char)ch);
-            ch = _stream->get();
-
-            if (ch <= 0)
-                syntaxError("unexpected end of file");
+            if (*_cur == 0)
+                break;
+            ++_cur;
         }
 
-        tok.setIndex(save(dest));
+        if (_cur >= _end || *_cur == 0)
+            syntaxError("unexpected end of file");
+
+        tok.setIndex(keep(slice(first)));
+        get();
+
         tok.setType(TOK_STRING);
     }
 
     void Scanner::scanSymbol(Token& tok)
     {
-        int ch = _stream->get();
-
-        if (isLetter(ch))
+        if (!isLetter(peek()))
         {
-            String cmp;
-            while (isValidIdentifier(ch))
-            {
-                cmp.push_back((char)ch);
-                ch = _stream->get();
-            }
+            get();
+            return;
+        }
 
-            _stream->putback((char)ch);
+        const char* first = cursor();
+        while (_cur < _end && isValidIdentifier((uint8_t)*_cur))
+            ++_cur;
 
-            if (cmp == "xml")
-                tok.setType(TOK_KW_XML);
-            else
-            {
-                // If it's not a reserved word
-                // save it as an identifier.
+        if (const StringView cmp = slice(first);
+            cmp == "xml")
+            tok.setType(TOK_KW_XML);
+        else
+        {
+            // If it's not a reserved word
+            // save it as an identifier.
 
-                tok.setType(TOK_IDENTIFIER);
-                tok.setIndex(save(cmp));
-            }
+            tok.setType(TOK_IDENTIFIER);
+            tok.setIndex(keep(cmp));
         }
     }
 
     void Scanner::scan(Token& tok)
     {
-        if (_stream == nullptr)
+        if (_cur == nullptr)
             syntaxError("No supplied stream");
 
         tok.clear();
 
         int ch;
-        while ((ch = _stream->get()) > 0)
+        while ((ch = get()) > 0)
         {
             tok.setLine(_line);
             if (_defaultState)
@@ -121,7 +149,7 @@ namespace Jam::Xml
                 switch (ch)
                 {
                 case '<':
-                    if (_stream->peek() == '!')
+                    if (peek() == '!')
                         scanMultiLineComment();
                     else
                     {
@@ -131,7 +159,7 @@ namespace Jam::Xml
                     break;
                 case '\'':
                 case '"':
-                    _stream->putback((char)ch);
+                    putback(ch);
                     scanString(tok);
                     return;
                 case '=':
@@ -151,13 +179,13 @@ namespace Jam::Xml
                 case Digits09:
                 case LowerCaseAz:
                 case UpperCaseAz:
-                    _stream->putback((char)ch);
+                    putback(ch);
                     scanSymbol(tok);
                     return;
                 case '\r':
                 case '\n':
-                    if (ch == '\r' && _stream->peek() == '\n')
-                        _stream->get();
+                    if (ch == '\r' && peek() == '\n')
+                        get();
                     ++_line;
                     break;
                 case ' ':
@@ -170,32 +198,30 @@ namespace Jam::Xml
             }
             else
             {
-                OutputStringStream oss;
+                putback(ch);
 
-                bool onlyWhiteSpace = true;
-                while (ch != '<')
+                const char* first          = cursor();
+                bool        onlyWhiteSpace = true;
+                while (_cur < _end && *_cur != '<' && *_cur != 0)
                 {
-                    oss << (char)ch;
-
                     if (onlyWhiteSpace)
-                        onlyWhiteSpace = isWhiteSpace(ch);
-
-                    ch = _stream->get();
-
-                    if (ch <= 0)
-                        break;
+                        onlyWhiteSpace = isWhiteSpace((uint8_t)*_cur);
+                    ++_cur;
                 }
 
-                _stream->putback((char)ch);
-
-                String dest = oss.str();
+                const StringView dest = slice(first);
 
                 _defaultState = true;
 
                 if (!dest.empty() && !onlyWhiteSpace)
                 {
-                    tok.setIndex(_code.size());
-                    _code.push_back(dest);
+                    if (_transient)
+                        tok.setIndex(keep(dest));
+                    else
+                    {
+                        tok.setIndex(_code.size());
+                        _code.push_back(dest);
+                    }
                     tok.setType(TOK_TEXT);
                     return;
                 }
@@ -25,15 +25,25 @@
 
 namespace Jam::Xml
 {
-    using CodeCache = std::vector<String>;
+    using CodeCache = std::vector<StringView>;
 
     class Scanner final : public ScannerBase
     {
+    public:
+        // Must be larger than the number of tokens
+        // a parser can look ahead.
+        static constexpr size_t RingSize = 16;
+
     private:
-        CodeCache _code;
+        CodeCache  _code;
+        StringView _ring[RingSize]{};
+        size_t     _ringNext{0};
+        bool       _transient{false};
 
         bool _defaultState;
 
+        size_t keep(const StringView& str);
+
         void scanSymbol(Token& tok);
 
         void scanString(Token& tok);
@@ -41,8 +51,23 @@ namespace Jam::Xml
     public:
         Scanner();
 
+        /**
+         * \brief Stops the scanner from saving every string it reads.
+         *
+         * In transient mode the strings of the last RingSize tokens are
+         * kept, so memory use does not grow with the input. Token
+         * indices must be passed to view, not to string or code.
+         */
+        void setTransient(bool transient);
+
+        // The view points into the scanned source.
+        StringView view(const size_t& idx) const;
+
         void scan(Token& tok) override;
 
         void getCode(String& dest, const size_t& idx);
+
+        // The view points into the scanned source.
+        StringView code(const size_t& idx);
     };
 }  // namespace Jam::Xml
@@ -32,12 +32,16 @@ namespace Jam
             return;
         }
 
-        dest.reserve(size);
-
-        for (size_t i = 0; i < size; ++i)
+        if (!dest.build(
+                filter,
+                size,
+                [](const TypeFilter& tf)
+                {
+                    return tf.typeName ? StringView(tf.typeName) : StringView();
+                },
+                [](const TypeFilter& tf) { return tf.typeCode; }))
         {
-            if (const char* str = filter[i].typeName; str != nullptr)
-                dest[String(str)] = filter[i].typeCode;
+            throw Exception("failed to build the type filter");
         }
     }
 
@@ -21,6 +21,7 @@
 */
 #pragma once
 #include <cstdint>
+#include "Utils/PerfectHash.h"
 #include "Utils/String.h"
 
 namespace Jam
@@ -31,7 +32,8 @@ namespace Jam
         int64_t     typeCode;
     };
 
-    using TypeFilterMap = std::unordered_map<String, int64_t>;
+    // The type names are referenced, not copied.
+    using TypeFilterMap = PerfectHash<int64_t, 0x100>;
 
     extern void makeTypeFilter(TypeFilterMap& dest, const TypeFilter*, size_t size);
 
@@ -20,104 +20,234 @@
 -------------------------------------------------------------------------------
 */
 #include "Xml/Writer.h"
-#include <iomanip>
+#include <fstream>
+#include "Utils/Char.h"
 #include "Utils/Exception.h"
 #include "Utils/FileSystem.h"
+#include "Xml/Entities.h"
 #include "Xml/Node.h"
 
 namespace Jam::Xml
 {
     constexpr size_t Indent = 2;
 
+    constexpr char   Spaces[]    = "                                                                ";
+    constexpr size_t SpacesCount = sizeof Spaces - 1;
+
     Writer::Writer(const Node* root) :
         _root(root),
         _indentBy{Indent}
     {
     }
 
-    void Writer::openTag(const Node* tag)
+    void Writer::indent(const size_t depth)
     {
-        if (!tag)
+        if (!_notMinify)
             return;
 
-        if (_notMinify)
+        size_t n = (size_t)_indentOffset + depth * (size_t)_indentBy;
+        while (n > 0)
         {
-            if (_indent > 0)
-                _out << std::setw((size_t)_indent) << ' ';
+            const size_t k = n < SpacesCount ? n : SpacesCount;
+            _buffer.append(Spaces, k);
+            n -= k;
         }
+    }
 
-        _out << '<' << tag->name();
-        writeAttributes(tag);
-        _out << '>';
+    void Writer::newLine()
+    {
+        if (_notMinify)
+            _buffer.push_back('\n');
+    }
 
-        if (_notMinify && !tag->hasText())
-            _out << std::endl;
+    void Writer::closePending()
+    {
+        if (_pending)
+        {
+            _pending = false;
+            _buffer.push_back('>');
+            newLine();
+        }
     }
 
-    void Writer::closeTag(const Node* tag)
+    void Writer::flush(const bool force)
     {
-        if (!tag)
-            return;
+        if (_sink && (force || _buffer.size() >= FlushSize))
+        {
+            _sink->write(_buffer.data(), (std::streamsize)_buffer.size());
+            _buffer.clear();
+        }
+    }
 
-        if (_notMinify)
+    void Writer::begin(OStream& output)
+    {
+        _sink    = &output;
+        _pending = false;
+        _buffer.clear();
+        _open.clear();
+
+        if (_writeXml)
         {
-            if (!tag->hasText() && (int)_indent > 0)
-                _out << std::setw(_indent) << ' ';
+            _buffer.append("<?xml version=\"1.0\"?>");
+            _buffer.push_back('\n');
         }
+    }
 
-        _out << '<' << '/' << tag->name() << '>';
+    void Writer::end()
+    {
+        while (!_open.empty())
+            endElement();
 
-        if (_notMinify)
-            _out << std::endl;
+        flush(true);
+        _sink = nullptr;
     }
 
-    void Writer::inlineTag(const Node* tag)
+    void Writer::beginElement(const StringView& name)
     {
-        if (!tag)
-            return;
+        if (!_open.empty() && !_open.back().hasText)
+            closePending();
 
-        if (_notMinify)
-            _out << std::setw(_indent) << ' ';
+        indent(_open.size());
+        _buffer.push_back('<');
+        _buffer.append(name.data(), name.size());
 
-        _out << '<'
-             << tag->name();
+        _open.push_back({name, false});
+        _pending = true;
+    }
 
-        writeAttributes(tag);
+    void Writer::attributeName(const StringView& name)
+    {
+        if (!_pending)
+            throw Exception("attributes must follow beginElement");
 
-        _out << '/' << '>';
+        _buffer.push_back(' ');
+        _buffer.append(name.data(), name.size());
+        _buffer.push_back('=');
+        _buffer.push_back('"');
+    }
 
-        if (_notMinify)
-            _out << std::endl;
+    void Writer::attribute(const StringView& name, const StringView& value)
+    {
+        attributeName(name);
+        escape(_buffer, value, true);
+        _buffer.push_back('"');
     }
 
-    void Writer::writeAttributes(const Node* tag)
+    void Writer::attribute(const StringView& name, const char* value)
     {
-        if (!tag)
-            return;
+        attribute(name, StringView(value ? value : ""));
+    }
+
+    void Writer::attribute(const StringView& name, const R32 value)
+    {
+        char buf[Char::MaxNumberLength];
+        attribute(name, StringView(buf, Char::toChars(buf, value)));
+    }
+
+    void Writer::attribute(const StringView& name, const R64 value)
+    {
+        char buf[Char::MaxNumberLength];
+        attribute(name, StringView(buf, Char::toChars(buf, value)));
+    }
+
+    void Writer::attribute(const StringView& name, const I32 value)
+    {
+        char buf[Char::MaxNumberLength];
+        attribute(name, StringView(buf, Char::toChars(buf, value)));
+    }
+
+    void Writer::attribute(const StringView& name, const U32 value)
+    {
+        char buf[Char::MaxNumberLength];
+        attribute(name, StringView(buf, Char::toChars(buf, value)));
+    }
 
-        if (tag->hasAttributes())
+    void Writer::attribute(const StringView& name, const I64 value)
+    {
+        char buf[Char::MaxNumberLength];
+        attribute(name, StringView(buf, Char::toChars(buf, value)));
+    }
+
+    void Writer::appendNumbers(const R32* values, const size_t count)
+    {
+        char buf[Char::MaxNumberLength];
+        for (size_t i = 0; i < count; ++i)
         {
-            const AttributeMap& attr = tag->attributes();
-            for (const auto& [k, v] : attr)
-            {
-                _out << ' ';
-                _out << k << '=' << '"' << v << '"';
-            }
+            if (i > 0)
+                _buffer.append(", ");
+            _buffer.append(buf, Char::toChars(buf, values[i]));
         }
     }
 
-    void Writer::writeFullTag(const Node* tag)
+    void Writer::appendNumbers(const U32* values, const size_t count)
     {
-        if (!tag)
-            return;
+        char buf[Char::MaxNumberLength];
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (i > 0)
+                _buffer.append(", ");
+            _buffer.append(buf, Char::toChars(buf, values[i]));
+        }
+    }
 
-        openTag(tag);
-        _out << tag->text();
+    void Writer::attribute(const StringView& name, const std::initializer_list<R32> values)
+    {
+        // numbers never need escaping, so the
+        // value is formatted in place
+        attributeName(name);
+        appendNumbers(values.begin(), values.size());
+        _buffer.push_back('"');
+    }
 
-        for (const Node* element : tag->children())
-            writeTag(element);
+    void Writer::attribute(const StringView& name, const std::initializer_list<U32> values)
+    {
+        attributeName(name);
+        appendNumbers(values.begin(), values.size());
+        _buffer.push_back('"');
+    }
 
-        closeTag(tag);
+    void Writer::text(const StringView& value)
+    {
+        if (_open.empty())
+            throw Exception("text must be inside an element");
+
+        if (_pending)
+        {
+            _pending = false;
+            _buffer.push_back('>');
+        }
+
+        _open.back().hasText = true;
+        escape(_buffer, value, false);
+    }
+
+    void Writer::endElement()
+    {
+        if (_open.empty())
+            throw Exception("endElement without a matching beginElement");
+
+        const Open open = _open.back();
+        _open.pop_back();
+
+        if (_pending)
+        {
+            _pending = false;
+            _buffer.push_back('/');
+            _buffer.push_back('>');
+        }
+        else
+        {
+            if (!open.hasText)
+                indent(_open.size());
+
+            _buffer.push_back('<');
+            _buffer.push_back('/');
+            _buffer.append(open.name.data(), open.name.size());
+            _buffer.push_back('>');
+        }
+        newLine();
+
+        flush(false);
     }
 
     void Writer::writeTag(const Node* tag)
@@ -125,26 +255,25 @@ namespace Jam::Xml
         if (!tag)
             return;
 
-        _indent += _indentBy;
+        beginElement(tag->name());
 
-        if (tag->hasChildren() || tag->hasText())
-            writeFullTag(tag);
-        else
-            inlineTag(tag);
+        for (const auto& [k, v] : tag->attributes())
+            attribute(k, v);
+
+        if (tag->hasText())
+            text(tag->text());
 
-        _indent -= _indentBy;
+        for (const Node* element : tag->children())
+            writeTag(element);
+
+        endElement();
     }
 
     void Writer::write(OStream& output)
     {
-        if (_writeXml)
-            _out << "<?xml version=\"1.0\"?>" << std::endl;
-
-        _indent = (_indentOffset - _indentBy);
+        begin(output);
         writeTag(_root);
-
-        const String dest = _out.str();
-        output.write(dest.c_str(), (std::streamsize)dest.size());
+        end();
     }
 
     void Writer::write(const String& path)
@@ -162,9 +291,13 @@ namespace Jam::Xml
                           const I32   indent,
                           const I32   offset)
     {
-        OutputStringStream oss;
-        toStream(oss, root, minify, indent, offset);
-        dest = oss.str();
+        Writer writer(root);
+        writer.setMinify(minify);
+        writer.setShowXmlHeader(false);
+        writer.setIndent(indent);
+        writer.setIndentOffset(offset);
+        writer.writeTag(root);
+        dest.swap(writer._buffer);
     }
 
     void Writer::toStream(OStream&    dest,
@@ -20,7 +20,10 @@
 -------------------------------------------------------------------------------
 */
 #pragma once
+#include <initializer_list>
+#include <vector>
 #include "Math/Integer.h"
+#include "Math/Real.h"
 #include "Utils/Definitions.h"
 #include "Utils/String.h"
 
@@ -39,32 +42,64 @@ namespace Jam::Xml
      * \brief Is a utility class that is used to write the xml
      * text structure to the supplied stream from the
      * supplied root node.
+     *
+     * Output is appended to one growable buffer that is reused between
+     * writes, and is handed to the stream in large blocks. Elements can
+     * also be written directly with beginElement and endElement, which
+     * skips building a Node tree. Numbers are formatted straight into the
+     * buffer.
+     *
+     * \code{.cpp}
+     * Xml::Writer writer;
+     * writer.begin(stream);
+     * writer.beginElement("grid");
+     * writer.attribute("origin", {0.f, 0.f});
+     * writer.endElement();
+     * writer.end();
+     * \endcode
      */
     class Writer
     {
+    public:
+        // The buffer is handed to the stream once it grows past this.
+        static constexpr size_t FlushSize = 0x10000;
+
     private:
-        const Node*        _root;
-        OutputStringStream _out;
-        int32_t            _indentBy{2};
-        int32_t            _indentOffset{0};
-        int32_t            _indent{0};
-        bool               _writeXml{true};
-        bool               _notMinify{false};
+        struct Open
+        {
+            StringView name;
+            bool       hasText;
+        };
+
+        const Node*       _root;
+        OStream*          _sink{nullptr};
+        String            _buffer;
+        std::vector<Open> _open;
+        int32_t           _indentBy{2};
+        int32_t           _indentOffset{0};
+        bool              _pending{false};
+        bool              _writeXml{true};
+        bool              _notMinify{false};
+
+        void indent(size_t depth);
+
+        void newLine();
 
-        void openTag(const Node* tag);
+        void closePending();
 
-        void closeTag(const Node* tag);
+        void flush(bool force);
 
-        void inlineTag(const Node* tag);
+        void attributeName(const StringView& name);
 
-        void writeAttributes(const Node* tag);
+        void appendNumbers(const R32* values, size_t count);
 
-        void writeFullTag(const Node* tag);
+        void appendNumbers(const U32* values, size_t count);
 
         void writeTag(const Node* tag);
 
+
     public:
-        explicit Writer(const Node* root);
+        explicit Writer(const Node* root = nullptr);
 
         ~Writer() = default;
 
@@ -76,6 +111,42 @@ namespace Jam::Xml
         void write(OStream& output);
         void write(const String& path);
 
+        /**
+         * \brief Starts writing elements directly to output.
+         *
+         * The xml header is written if it is enabled.
+         */
+        void begin(OStream& output);
+
+        // Writes what is left in the buffer and detaches the stream.
+        void end();
+
+        // The name is referenced, not copied, until endElement.
+        void beginElement(const StringView& name);
+
+        void attribute(const StringView& name, const StringView& value);
+
+        void attribute(const StringView& name, const char* value);
+
+        void attribute(const StringView& name, R32 value);
+
+        void attribute(const StringView& name, R64 value);
+
+        void attribute(const StringView& name, I32 value);
+
+        void attribute(const StringView& name, U32 value);
+
+        void attribute(const StringView& name, I64 value);
+
+        // Written as a list separated by ", ".
+        void attribute(const StringView& name, std::initializer_list<R32> values);
+
+        void attribute(const StringView& name, std::initializer_list<U32> values);
+
+        void text(const StringView& value);
+
+        void endElement();
+
         static void toString(String&     dest,
                              const Node* root,
                              bool        minify = true,
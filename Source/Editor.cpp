@@ -27,6 +27,7 @@
 #include "Interface/Widgets/IconButton.h"
 #include "Math/Lg.h"
 #include "State/App.h"
+#include "State/OutputLogMonitor.h"
 #include "Utils/Exception.h"
 #include "Utils/ScopePtr.h"
 
@@ -51,6 +52,9 @@ namespace Jam::Editor
         // State should only be valid during the
         // following scope
         State::App::initialize();
+
+        if (arguments().contains("--verbose"))
+            State::outputState()->setVerbose(true);
     }
 
     void EditorApp::destruct()
@@ -59,6 +59,7 @@ namespace Jam::Editor
                 updateRecent(fileName);
 
                 swapLayout(state->layout());
+                state->releaseLayout();
 
                 // save the current path information
 
@@ -79,7 +79,7 @@ namespace Jam::Editor
             show();
     }
 
-    void Application::swapLayout(const String& string)
+    void Application::swapLayout(const XmlNode* layout)
     {
         if (_mainArea)
         {
@@ -88,7 +88,7 @@ namespace Jam::Editor
             delete _mainArea;
         }
 
-        _mainArea = new MainArea(string, this);
+        _mainArea = new MainArea(layout, this);
         setCentralWidget(_mainArea);
     }
 
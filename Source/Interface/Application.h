@@ -24,6 +24,7 @@
 #include <QMainWindow>
 #include "RememberLastCache.h"
 #include "Utils/Path.h"
+#include "Xml/Declarations.h"
 
 class QProcess;
 
@@ -65,7 +66,7 @@ namespace Jam::Editor
 
         void constructMenuBar();
 
-        void swapLayout(const String& string);
+        void swapLayout(const XmlNode* layout);
 
         void loadProjectFromPath(const QString& fileName);
 
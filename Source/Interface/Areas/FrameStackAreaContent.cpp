@@ -66,6 +66,11 @@ namespace Jam::Editor
                 &State::FrameStackManager::stateChanged,
                 this,
                 &FrameStackAreaContent::stateChanged);
+        connect(&_renderer,
+                &FrameStackRenderer::frameReady,
+                this,
+                [=]
+                { update(); });
 
         resetAxis();
     }
@@ -88,11 +93,11 @@ namespace Jam::Editor
         _screen.init({0.f, 0.f});
         _screen.reset();
 
-        (void)stack->injectVec2(X_AXIS, {minSquare, 1});
-        (void)stack->injectVec2(Y_AXIS, {minSquare, 1});
-        (void)stack->injectVec2(ORIGIN, _screen.origin());
+        stack->post(X_AXIS, {minSquare, 1});
+        stack->post(Y_AXIS, {minSquare, 1});
+        stack->post(ORIGIN, _screen.origin());
 
-        update();
+        requestFrame();
     }
 
     Vec2F FrameStackAreaContent::updatePoint(
@@ -115,21 +120,20 @@ namespace Jam::Editor
         _screen.setViewport(0, 0, sz.width(), sz.height());
         _screen.reset();
 
-        (void)State::layerStack()->injectVec2(SIZE, _screen.viewport().extent());
-        update();
+        State::layerStack()->post(SIZE, _screen.viewport().extent());
+        requestFrame();
+    }
+
+    void FrameStackAreaContent::requestFrame()
+    {
+        _renderer.request(_screen, size(), devicePixelRatioF());
     }
 
     void FrameStackAreaContent::paintEvent(QPaintEvent* event)
     {
+        // frames are drawn by the renderer, this only copies the last one
         QPainter paint(this);
-        paint.setRenderHint(QPainter::Antialiasing);
-
-        RenderContext canvas(&paint, _screen);
-        //canvas.setSize(Vec2I{(width()), (height())});
-        canvas.clear(0x10, 0x10, 0x10, 0x80);
-
-        if (const auto stk = State::layerStack())
-            stk->render(&canvas);
+        _renderer.paint(paint);
     }
 
     void FrameStackAreaContent::resizeEvent(QResizeEvent* event)
@@ -145,10 +149,9 @@ namespace Jam::Editor
         _scrollX += d;
         _scrollY += d;
 
-        (void)stack->injectVec2(X_STEP, {_scrollX, 0.f});
-        (void)stack->injectVec2(Y_STEP, {_scrollY, 0.f});
+        stack->post(X_STEP, {_scrollX, 0.f});
+        stack->post(Y_STEP, {_scrollY, 0.f});
 
-        update();
         event->accept();
     }
 
@@ -182,8 +185,7 @@ namespace Jam::Editor
             const Vec2F p = updatePoint(event);
             _screen.translate(-p.x, -p.y);
 
-            if (State::layerStack()->injectVec2(ORIGIN, _screen.offset()))
-                update();
+            State::layerStack()->post(ORIGIN, _screen.offset());
         }
         QWidget::mouseMoveEvent(event);
     }
@@ -215,11 +217,10 @@ namespace Jam::Editor
             _scrollX = vec.x;
         if (code == Y_STEP)
             _scrollY = vec.x;
-        update();
     }
 
     void FrameStackAreaContent::stateChanged()
     {
-        update();
+        requestFrame();
     }
 }  // namespace Jam::Editor
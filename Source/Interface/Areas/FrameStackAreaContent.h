@@ -21,6 +21,7 @@
 */
 #pragma once
 #include <QWidget>
+#include "FrameStackRenderer.h"
 #include "Math/Screen.h"
 #include "State/FrameStack/GridLayer.h"
 
@@ -43,6 +44,8 @@ namespace Jam::Editor
         R32    _scrollX{0};
         R32    _scrollY{0};
 
+        FrameStackRenderer _renderer;
+
     public:
         explicit FrameStackAreaContent(QWidget* parent = nullptr);
         ~FrameStackAreaContent() override;
@@ -56,6 +59,8 @@ namespace Jam::Editor
 
         void updateSize(const QSize& sz);
 
+        void requestFrame();
+
         void paintEvent(QPaintEvent* event) override;
 
         void resizeEvent(QResizeEvent* event) override;
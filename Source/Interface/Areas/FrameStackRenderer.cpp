@@ -0,0 +1,132 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "FrameStackRenderer.h"
+#include <QPainter>
+#include "State/App.h"
+#include "State/FrameStack/RenderContext.h"
+#include "State/FrameStackManager.h"
+
+namespace Jam::Editor
+{
+    FrameStackRenderer::FrameStackRenderer()
+    {
+        _thread = std::thread(&FrameStackRenderer::main, this);
+    }
+
+    FrameStackRenderer::~FrameStackRenderer()
+    {
+        {
+            std::lock_guard lock(_mutex);
+            _quit = true;
+        }
+        _wake.notify_one();
+        _thread.join();
+    }
+
+    void FrameStackRenderer::request(const Screen& screen,
+                                     const QSize&  size,
+                                     const qreal   ratio)
+    {
+        {
+            std::lock_guard lock(_mutex);
+            _screen = screen;
+            _size   = size;
+            _ratio  = ratio;
+            _dirty  = true;
+        }
+        _wake.notify_one();
+    }
+
+    void FrameStackRenderer::paint(QPainter& painter)
+    {
+        std::lock_guard lock(_mutex);
+
+        const QImage& front = _buffers[_front];
+        if (!front.isNull())
+            painter.drawImage(0, 0, front);
+    }
+
+    void FrameStackRenderer::renderFrame(QImage&       dest,
+                                         const Screen& screen,
+                                         const QSize&  size,
+                                         const qreal   ratio) const
+    {
+        const QSize pixels = size * ratio;
+        if (dest.size() != pixels)
+            dest = QImage(pixels, QImage::Format_ARGB32_Premultiplied);
+
+        dest.setDevicePixelRatio(ratio);
+        dest.fill(Qt::transparent);
+
+        QPainter paint(&dest);
+        paint.setRenderHint(QPainter::Antialiasing);
+
+        State::RenderContext canvas(&paint, screen);
+        canvas.clear(0x10, 0x10, 0x10, 0x80);
+
+        if (const auto stk = State::layerStack())
+            stk->render(&canvas);
+    }
+
+    void FrameStackRenderer::main()
+    {
+        Screen screen;
+        QSize  size;
+        qreal  ratio;
+
+        for (;;)
+        {
+            {
+                std::unique_lock lock(_mutex);
+                _wake.wait(lock, [this] { return _quit || _dirty; });
+                if (_quit)
+                    return;
+
+                _dirty = false;
+                screen = _screen;
+                size   = _size;
+                ratio  = _ratio;
+            }
+
+            if (size.isEmpty())
+                continue;
+
+            // the back buffer is only touched by this thread
+            QImage& back = _buffers[_front ^ 1];
+            try
+            {
+                renderFrame(back, screen, size, ratio);
+            }
+            catch (Exception&)
+            {
+                continue;
+            }
+
+            {
+                std::lock_guard lock(_mutex);
+                _front ^= 1;
+            }
+            emit frameReady();
+        }
+    }
+
+}  // namespace Jam::Editor
@@ -0,0 +1,82 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+#include <QImage>
+#include <QObject>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "Math/Screen.h"
+
+class QPainter;
+
+namespace Jam::Editor
+{
+    /**
+     * \brief Renders the frame stack on its own thread into a pair of
+     * images.
+     *
+     * Requests only mark the frame as dirty, so a burst of requests that
+     * arrives while a frame is being drawn results in one more frame.
+     * When a frame completes the buffers are swapped and frameReady is
+     * emitted. Painting then only copies the front buffer.
+     */
+    class FrameStackRenderer final : public QObject
+    {
+        Q_OBJECT
+
+    signals:
+        void frameReady() const;
+
+    private:
+        std::thread             _thread;
+        std::mutex              _mutex;
+        std::condition_variable _wake;
+
+        QImage _buffers[2];
+        U8     _front{0};
+
+        Screen _screen;
+        QSize  _size;
+        qreal  _ratio{1};
+        bool   _dirty{false};
+        bool   _quit{false};
+
+        void main();
+
+        void renderFrame(QImage&       dest,
+                         const Screen& screen,
+                         const QSize&  size,
+                         qreal         ratio) const;
+
+    public:
+        FrameStackRenderer();
+        ~FrameStackRenderer() override;
+
+        // Requests a new frame of the supplied view.
+        void request(const Screen& screen, const QSize& size, qreal ratio);
+
+        // Copies the latest completed frame.
+        void paint(QPainter& painter);
+    };
+
+}  // namespace Jam::Editor
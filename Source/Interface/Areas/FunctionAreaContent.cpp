@@ -68,7 +68,17 @@ namespace Jam::Editor
     void FunctionAreaContent::addSlider(State::VariableStateObject* obj) const
     {
         if (obj == nullptr)
-            obj = State::functionLayer()->createVariable();
+        {
+            // the object is made here and handed to the layer
+            // by the next frame, so a frame in progress is
+            // never waited on
+            obj = new State::VariableStateObject();
+
+            const auto layer = State::functionLayer();
+            State::layerStack()->post(
+                [layer, obj]
+                { layer->addVariable(obj); });
+        }
 
         if (obj == nullptr)  // unlikely
             throw Exception("invalid state object");
@@ -87,7 +97,17 @@ namespace Jam::Editor
     void FunctionAreaContent::addExpression(State::ExpressionStateObject* obj) const
     {
         if (obj == nullptr)
-            obj = State::functionLayer()->createExpression();
+        {
+            // the object is made here and handed to the layer
+            // by the next frame, so a frame in progress is
+            // never waited on
+            obj = new State::ExpressionStateObject();
+
+            const auto layer = State::functionLayer();
+            State::layerStack()->post(
+                [layer, obj]
+                { layer->addExpression(obj); });
+        }
 
         if (obj == nullptr)  // unlikely
             throw Exception("invalid state object");
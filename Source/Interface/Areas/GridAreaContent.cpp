@@ -110,13 +110,13 @@ namespace Jam::Editor
     void GridAreaContent::xAxisUpdate(const I32 v)
     {
         if (const auto stack = layerStack())
-            (void)stack->injectVec2(X_STEP, {R32(v), 0});
+            stack->post(X_STEP, {R32(v), 0});
     }
 
     void GridAreaContent::yAxisUpdate(const I32 v)
     {
         if (const auto stack = layerStack())
-            (void)stack->injectVec2(Y_STEP, {R32(v), 0});
+            stack->post(Y_STEP, {R32(v), 0});
     }
 
 }  // namespace Jam::Editor
\ No newline at end of file
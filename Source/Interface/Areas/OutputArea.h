@@ -80,6 +80,14 @@ namespace Jam::Editor
                 Con::println(oss.str().c_str());
         }
 
+        // True if diagnostic output should be written, so
+        // callers can skip building it when it is not.
+        inline bool isVerbose()
+        {
+            const auto out = State::outputState();
+            return out && out->isVerbose();
+        }
+
         inline void clear()
         {
             if (const auto out = State::outputState())
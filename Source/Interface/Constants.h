@@ -37,6 +37,7 @@ namespace Jam::Editor::Const
     constexpr int NormalFactor   = 125;
     constexpr int SubtleFactor   = 105;
     constexpr int AreaPadding    = 2;
+    constexpr int PreviewDelay   = 16;
 
     constexpr QRole SplitterRole  = QRole::Shadow;
     constexpr QRole ToolRole      = QRole::Midlight;
@@ -50,6 +50,25 @@ namespace Jam::Editor
             construct(layout);
     }
 
+    MainArea::MainArea(const XmlNode* layout, QWidget* parent) :
+        QWidget(parent),
+        _creator(new MainAreaCreator())
+    {
+        if (!layout)
+            construct();
+        else
+        {
+            try
+            {
+                construct(layout);
+            }
+            catch (Exception& ex)
+            {
+                handleBuildError(ex.what());
+            }
+        }
+    }
+
     MainArea::~MainArea()
     {
         delete _layout;
@@ -81,9 +100,7 @@ namespace Jam::Editor
             XmlFile parser(State::AreaLayoutTags,
                            State::AreaLayoutTagsMax);
 
-            StringStream ss;
-            ss << layout;
-            parser.read(ss);
+            parser.readText(layout);
             if (const auto root = parser.root(State::TreeTag))
                 construct(root);
             else
@@ -97,7 +114,8 @@ namespace Jam::Editor
 
     void MainArea::construct(const XmlNode* node)
     {
-        // Note: used only as an extension of construct(const QString& layout)
+        // Note: used as an extension of construct(const String& layout)
+        // and directly with the tree node of an already parsed project
 
         _layout = new QVBoxLayout();
         View::layoutDefaults(_layout);
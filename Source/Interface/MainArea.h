@@ -75,6 +75,10 @@ namespace Jam::Editor
     public:
         explicit MainArea(const String& layout = "",
                           QWidget*       parent = nullptr);
+
+        explicit MainArea(const XmlNode* layout,
+                          QWidget*       parent = nullptr);
+
         ~MainArea() override;
 
         void dumpDisplayTree();
@@ -21,7 +21,9 @@
 */
 #include "ExpressionWidget.h"
 #include <qboxlayout.h>
+#include <QTimer>
 #include "IconButton.h"
+#include "Interface/Areas/OutputArea.h"
 #include "Interface/Constants.h"
 #include "Interface/Extensions.h"
 #include "State/App.h"
@@ -52,6 +54,12 @@ namespace Jam::Editor
         _del = IconButton::create(Icons::Delete);
         View::copyColorRoles(_del, this);
 
+        // typing restarts the timer, so the expression
+        // is only recompiled once the edits pause
+        _preview = new QTimer(this);
+        _preview->setSingleShot(true);
+        _preview->setInterval(Const::PreviewDelay);
+
         layout->addWidget(_line, 1);
         layout->addWidget(_del);
 
@@ -65,6 +73,14 @@ namespace Jam::Editor
                 &StringWidget::editingFinished,
                 this,
                 &ExpressionWidget::textEntered);
+        connect(_line,
+                &StringWidget::textEdited,
+                this,
+                &ExpressionWidget::textEdited);
+        connect(_preview,
+                &QTimer::timeout,
+                this,
+                &ExpressionWidget::previewTimeout);
         connect(_del,
                 &QPushButton::clicked,
                 this,
@@ -74,17 +90,56 @@ namespace Jam::Editor
 
     void ExpressionWidget::onDelete()
     {
-        State::functionLayer()->removeExpression(_state);
+        const auto layer = State::functionLayer();
+        State::layerStack()->post(
+            [state = _state, layer]
+            { layer->removeExpression(state); });
+
         _state = nullptr;
         emit wantsToDelete();
     }
 
+    void ExpressionWidget::textEdited(const String& text)
+    {
+        _pending = text;
+        _preview->start();
+    }
+
+    void ExpressionWidget::previewTimeout() const
+    {
+        apply(_pending, false);
+    }
+
     void ExpressionWidget::textEntered(const String& text) const
     {
+        apply(text, true);
+    }
+
+    void ExpressionWidget::apply(const String& text, const bool report) const
+    {
+        _preview->stop();
         if (_state)
         {
-            _state->setText(text);
-            State::layerStack()->notifyStateChange();
+            const auto stack   = State::layerStack();
+            const bool verbose = report && Log::isVerbose();
+
+            stack->post(
+                [stack, state = _state, text, report, verbose]
+                {
+                    state->setText(text);
+
+                    // most previews are of unfinished text, so
+                    // errors wait for the edit to be finished
+                    if (report && !state->error().empty())
+                        stack->reportError(state->error());
+                    else if (verbose)
+                    {
+                        OutputStringStream ss;
+                        state->printSymbols(ss);
+                        stack->reportError(ss.str());
+                    }
+                });
+            stack->notifyStateChange();
         }
     }
 
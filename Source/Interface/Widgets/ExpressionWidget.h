@@ -24,6 +24,8 @@
 #include "IconButton.h"
 #include "Utils/String.h"
 
+class QTimer;
+
 namespace Jam::Editor
 {
     namespace State
@@ -42,6 +44,8 @@ namespace Jam::Editor
     private:
         StringWidget* _line{nullptr};
         IconButton*   _del{nullptr};
+        QTimer*       _preview{nullptr};
+        String        _pending{};
 
         State::ExpressionStateObject* _state{nullptr};
 
@@ -57,6 +61,12 @@ namespace Jam::Editor
 
         void textEntered(const String& text) const;
 
+        void textEdited(const String& text);
+
+        void previewTimeout() const;
+
+        void apply(const String& text, bool report) const;
+
         void onDelete();
     };
 
@@ -59,6 +59,11 @@ namespace Jam::Editor
         emit editingFinished(_str);
     }
 
+    void StringWidget::edited(const QString& text)
+    {
+        emit textEdited(text.toStdString());
+    }
+
     void StringWidget::connectSignals()
     {
         connect(_line,
@@ -69,6 +74,10 @@ namespace Jam::Editor
                 &QLineEdit::returnPressed,
                 this,
                 &StringWidget::finished);
+        connect(_line,
+                &QLineEdit::textEdited,
+                this,
+                &StringWidget::edited);
     }
 
     void StringWidget::setText(const String& str)
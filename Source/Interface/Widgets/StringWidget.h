@@ -34,6 +34,9 @@ namespace Jam::Editor
     signals:
         void editingFinished(const String& text);
 
+        // Emitted for every change the user makes while typing.
+        void textEdited(const String& text);
+
     private:
         QLineEdit* _line{nullptr};
         String     _str{};
@@ -55,6 +58,8 @@ namespace Jam::Editor
         void connectSignals();
 
         void finished();
+
+        void edited(const QString& text);
     };
 
     inline const String& StringWidget::text() const
@@ -83,24 +83,39 @@ namespace Jam::Editor
     {
         if (_state)
         {
-            _state->setRange(data.range);
-            _state->setName(data.name);
-            _state->setRate(data.rate);
-            _state->setValue(data.value);
+            State::layerStack()->post(
+                [state = _state, data]
+                {
+                    state->setRange(data.range);
+                    state->setName(data.name);
+                    state->setRate(data.rate);
+                    state->setValue(data.value);
+                });
         }
     }
 
     void VariableWidget::onValueChange(const R32& data) const
     {
-        _state->setValue(data);
-
-        State::layerStack()->notifyStateChange();
-        State::functionLayer()->update();
+        if (_state)
+        {
+            const auto layer = State::functionLayer();
+            State::layerStack()->post(
+                [state = _state, layer, data]
+                {
+                    state->setValue(data);
+                    layer->update();
+                });
+            State::layerStack()->notifyStateChange();
+        }
     }
 
     void VariableWidget::onDelete()
     {
-        State::functionLayer()->removeVariable(_state);
+        const auto layer = State::functionLayer();
+        State::layerStack()->post(
+            [state = _state, layer]
+            { layer->removeVariable(state); });
+
         _state = nullptr;
         State::layerStack()->notifyStateChange();
 
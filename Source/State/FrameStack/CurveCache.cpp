@@ -0,0 +1,279 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "State/FrameStack/CurveCache.h"
+#include <cstring>
+
+namespace Jam::Editor::State
+{
+    bool CurveCache::readInputs(Eq::Statement& stmt, const Eq::Program& code)
+    {
+        stmt.readInputs(code, code.indexOf("x"), _current);
+
+        if (_current.size() != _inputs.size())
+            return false;
+        // bit patterns compare NaN equal to itself, so an undefined
+        // input does not invalidate the cache on every frame
+        return _current.empty() ||
+               memcmp(_current.data(), _inputs.data(), _current.size() * sizeof(R64)) == 0;
+    }
+
+    bool CurveCache::isValid(const CurveSampler& sampler,
+                             const Eq::Program&  code,
+                             const Axis&         axis,
+                             const R64           v0,
+                             const R64           v1,
+                             const R64           yLo,
+                             const R64           yHi) const
+    {
+        if (!_valid || _program != code.id())
+            return false;
+
+        if (_scale[0] != axis.x.n() || _scale[1] != axis.x.d() ||
+            _scale[2] != axis.y.n() || _scale[3] != axis.y.d())
+            return false;
+
+        if (_tolerance != sampler.tolerance())
+            return false;
+
+        // the view must lie inside the band the samples were refined for
+        if (yLo < _yLo || yHi > _yHi)
+            return false;
+
+        // the cached range must touch the view, so extending it only
+        // samples the newly exposed columns
+        return v0 <= _x1 && v1 >= _x0;
+    }
+
+    void CurveCache::trim(const R64 x0, const R64 x1, const R64 step)
+    {
+        // grid points are computed from different starts, so the
+        // sample at an end can be off by a rounding error
+        const R64 eps = step * 1e-6;
+
+        if (x0 > _x0)
+        {
+            U32 first = 0;
+            while (first < _samples.size() && _samples[first].x < x0 - eps)
+                ++first;
+
+            _scratch.resizeFast(0);
+            for (U32 i = first; i < _samples.size(); ++i)
+                _scratch.push_back(_samples[i]);
+
+            _samples.resizeFast(0);
+            for (const CurveSample& pt : _scratch)
+                _samples.push_back(pt);
+            _x0 = x0;
+        }
+
+        if (x1 < _x1)
+        {
+            while (_samples.isNotEmpty() && _samples.back().x > x1 + eps)
+                _samples.pop_back();
+            _x1 = x1;
+        }
+    }
+
+    void CurveCache::split(const Eq::Program& code,
+                           const R64          x0,
+                           const R64          x1,
+                           const R64          step,
+                           const U32          chunk,
+                           SampleTasks&       tasks) const
+    {
+        const U32 n = U32(round((x1 - x0) / step));
+        const U32 c = Max<U32>(chunk, 1);
+
+        for (U32 i = 0; i < n; i += c)
+        {
+            SampleTask& task = tasks.emplace_back();
+
+            task.code   = &code;
+            task.inputs = &_current;
+            task.x0     = x0 + R64(i) * step;
+            task.x1     = i + c < n ? x0 + R64(i + c) * step : x1;
+            task.yLo    = _yLo;
+            task.yHi    = _yHi;
+        }
+    }
+
+    void CurveCache::append(CurveSamples&       dest,
+                            const CurveSamples& piece,
+                            const R64           start)
+    {
+        // Pieces share their end points. The copy in dest is replaced,
+        // and the two sides only connect if both are defined at start.
+        const bool reached = dest.isNotEmpty() &&
+                             !CurveSampler::isBreak(dest.back()) &&
+                             dest.back().x >= start;
+
+        while (dest.isNotEmpty() && dest.back().x >= start)
+            dest.pop_back();
+
+        if (dest.isNotEmpty() && !CurveSampler::isBreak(dest.back()))
+        {
+            if (!reached || piece.empty() || piece[0].x > start)
+                dest.push_back({start, NAN});
+        }
+
+        for (const CurveSample& pt : piece)
+            dest.push_back(pt);
+    }
+
+    void CurveCache::sample(CurveSampler&  sampler,
+                            Eq::Statement& stmt,
+                            const Axis&    axis,
+                            SampleTask&    task)
+    {
+        const Eq::Program& code = *task.code;
+        stmt.writeInputs(code, code.indexOf("x"), *task.inputs);
+
+        task.samples.resizeFast(0);
+        sampler.sample(stmt,
+                       code,
+                       axis,
+                       task.x0,
+                       task.x1,
+                       task.yLo,
+                       task.yHi,
+                       task.samples);
+    }
+
+    U32 CurveCache::prepare(const CurveSampler& sampler,
+                            Eq::Statement&      stmt,
+                            const Eq::Program&  code,
+                            const Axis&         axis,
+                            R64                 v0,
+                            R64                 v1,
+                            const R64           yLo,
+                            const R64           yHi,
+                            SampleTasks&        tasks,
+                            const U32           chunk)
+    {
+        const R64 step = sampler.step(axis);
+        if (code.empty() || !(step > 0) || !(v1 > v0))
+        {
+            _valid = false;
+            _reset = true;
+            return 0;
+        }
+
+        // align the view to the sampling grid
+        v0 = floor(v0 / step) * step;
+        v1 = ceil(v1 / step) * step;
+
+        const size_t first = tasks.size();
+        const bool   same  = readInputs(stmt, code);
+        if (!same || !isValid(sampler, code, axis, v0, v1, yLo, yHi))
+        {
+            const R64 h = yHi - yLo;
+
+            _inputs.resizeFast(0);
+            for (const R64 v : _current)
+                _inputs.push_back(v);
+
+            _program   = code.id();
+            _scale[0]  = axis.x.n();
+            _scale[1]  = axis.x.d();
+            _scale[2]  = axis.y.n();
+            _scale[3]  = axis.y.d();
+            _tolerance = sampler.tolerance();
+            _x0        = v0;
+            _x1        = v1;
+            _yLo       = yLo - h;
+            _yHi       = yHi + h;
+            _valid     = true;
+            _reset     = true;
+
+            split(code, v0, v1, step, chunk, tasks);
+        }
+        else
+        {
+            _reset = false;
+            _v0    = v0;
+            _v1    = v1;
+
+            // keep one view width of samples on either side, so panning
+            // in one direction never grows the cache without bound
+            const R64 w = v1 - v0;
+            if (_x0 < v0 - w || _x1 > v1 + w)
+                trim(Max(_x0, v0 - w), Min(_x1, v1 + w), step);
+
+            if (v0 < _x0)
+                split(code, v0, _x0, step, chunk, tasks);
+            if (v1 > _x1)
+                split(code, _x1, v1, step, chunk, tasks);
+        }
+        return U32(tasks.size() - first);
+    }
+
+    const CurveSamples& CurveCache::commit(const SampleTask* tasks,
+                                           const U32         count)
+    {
+        U32 i = 0;
+        if (_reset)
+        {
+            _reset = false;
+            _samples.resizeFast(0);
+            for (; i < count; ++i)
+                append(_samples, tasks[i].samples, tasks[i].x0);
+            return _samples;
+        }
+
+        // tasks to the left of the cached range come first
+        if (i < count && tasks[i].x1 <= _x0)
+        {
+            _scratch.resizeFast(0);
+            for (; i < count && tasks[i].x1 <= _x0; ++i)
+                append(_scratch, tasks[i].samples, tasks[i].x0);
+            append(_scratch, _samples, _x0);
+
+            _samples.resizeFast(0);
+            for (const CurveSample& pt : _scratch)
+                _samples.push_back(pt);
+            _x0 = _v0;
+        }
+
+        for (; i < count; ++i)
+            append(_samples, tasks[i].samples, tasks[i].x0);
+        _x1 = Max(_x1, _v1);
+        return _samples;
+    }
+
+    const CurveSamples& CurveCache::update(CurveSampler&      sampler,
+                                           Eq::Statement&     stmt,
+                                           const Eq::Program& code,
+                                           const Axis&        axis,
+                                           const R64          v0,
+                                           const R64          v1,
+                                           const R64          yLo,
+                                           const R64          yHi)
+    {
+        _tasks.clear();
+
+        const U32 n = prepare(sampler, stmt, code, axis, v0, v1, yLo, yHi, _tasks);
+        for (SampleTask& task : _tasks)
+            sample(sampler, stmt, axis, task);
+        return commit(_tasks.data(), n);
+    }
+
+}  // namespace Jam::Editor::State
@@ -0,0 +1,165 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+#include <vector>
+#include "State/FrameStack/CurveSampler.h"
+
+namespace Jam::Editor::State
+{
+    /**
+     * \brief A grid aligned range of one expression that needs sampling.
+     *
+     * The inputs are the values of the variables the program reads, in
+     * program order with x skipped, so a task can be evaluated with any
+     * statement.
+     */
+    struct SampleTask
+    {
+        const Eq::Program*   code{nullptr};
+        const Eq::ValueList* inputs{nullptr};
+
+        R64 x0{0};
+        R64 x1{0};
+        R64 yLo{0};
+        R64 yHi{0};
+
+        CurveSamples samples;
+    };
+
+    using SampleTasks = std::vector<SampleTask>;
+
+    /**
+     * \brief Holds the world space samples of one expression.
+     *
+     * The samples stay valid for as long as the program, the values of the
+     * variables it reads, the axis scale and the sampler tolerance are
+     * unchanged. Panning only samples the newly exposed columns, and a
+     * vertical pan is free while the view stays within the band the
+     * curve was refined for.
+     *
+     * Updating is split into prepare, which appends the ranges that are
+     * missing as tasks, and commit, which stitches the sampled tasks into
+     * the cache. The tasks may be sampled on any thread in between.
+     */
+    class CurveCache
+    {
+    private:
+        CurveSamples  _samples;
+        CurveSamples  _scratch;
+        SampleTasks   _tasks;
+        Eq::ValueList _inputs;
+        Eq::ValueList _current;
+        U32           _program{0};
+        U32           _scale[4]{};
+        R32           _tolerance{0};
+        R64           _x0{0};
+        R64           _x1{0};
+        R64           _yLo{0};
+        R64           _yHi{0};
+        R64           _v0{0};
+        R64           _v1{0};
+        bool          _valid{false};
+        bool          _reset{false};
+
+        bool readInputs(Eq::Statement& stmt, const Eq::Program& code);
+
+        bool isValid(const CurveSampler& sampler,
+                     const Eq::Program&  code,
+                     const Axis&         axis,
+                     R64                 v0,
+                     R64                 v1,
+                     R64                 yLo,
+                     R64                 yHi) const;
+
+        // Drops the samples outside [x0, x1], both on the sampling grid.
+        void trim(R64 x0, R64 x1, R64 step);
+
+        void split(const Eq::Program& code,
+                   R64                x0,
+                   R64                x1,
+                   R64                step,
+                   U32                chunk,
+                   SampleTasks&       tasks) const;
+
+        static void append(CurveSamples&       dest,
+                           const CurveSamples& piece,
+                           R64                 start);
+
+    public:
+        CurveCache() = default;
+
+        /**
+         * \brief Appends the ranges that are missing from the visible
+         * range [v0, v1] x [yLo, yHi] to tasks.
+         *
+         * Ranges are split into tasks of at most chunk grid steps.
+         * Returns the number of tasks appended.
+         */
+        U32 prepare(const CurveSampler& sampler,
+                    Eq::Statement&      stmt,
+                    const Eq::Program&  code,
+                    const Axis&         axis,
+                    R64                 v0,
+                    R64                 v1,
+                    R64                 yLo,
+                    R64                 yHi,
+                    SampleTasks&        tasks,
+                    U32                 chunk = JtNpos32);
+
+        // Stitches the tasks appended by the last call to prepare.
+        const CurveSamples& commit(const SampleTask* tasks, U32 count);
+
+        /**
+         * \brief Brings the samples up to date for the visible range
+         * [v0, v1] x [yLo, yHi] on the calling thread and returns them.
+         */
+        const CurveSamples& update(CurveSampler&      sampler,
+                                   Eq::Statement&     stmt,
+                                   const Eq::Program& code,
+                                   const Axis&        axis,
+                                   R64                v0,
+                                   R64                v1,
+                                   R64                yLo,
+                                   R64                yHi);
+
+        void invalidate();
+
+        const CurveSamples& samples() const;
+
+        // Samples the task with the supplied statement.
+        static void sample(CurveSampler&  sampler,
+                           Eq::Statement& stmt,
+                           const Axis&    axis,
+                           SampleTask&    task);
+    };
+
+    inline void CurveCache::invalidate()
+    {
+        _valid = false;
+    }
+
+    inline const CurveSamples& CurveCache::samples() const
+    {
+        return _samples;
+    }
+
+}  // namespace Jam::Editor::State
@@ -0,0 +1,220 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "State/FrameStack/CurveSampler.h"
+
+namespace Jam::Editor::State
+{
+    CurveSample CurveSampler::coarse(const U32 i) const
+    {
+        return {_xs[i], std::isfinite(_ys[i]) ? _ys[i] : NAN};
+    }
+
+    CurveSample CurveSampler::eval(const R64 x)
+    {
+        ++_evaluations;
+        _stmt->setSlot(_slot, x);
+
+        const R64 y = _stmt->execute(*_code);
+        return {x, std::isfinite(y) ? y : NAN};
+    }
+
+    bool CurveSampler::isOutside(const CurveSample& a,
+                                 const CurveSample& b,
+                                 const CurveSample& m) const
+    {
+        return (a.y < _yLo && b.y < _yLo && m.y < _yLo) ||
+               (a.y > _yHi && b.y > _yHi && m.y > _yHi);
+    }
+
+    Eq::Interval CurveSampler::enclose(const CurveSample& a, const CurveSample& b)
+    {
+        ++_evaluations;
+        return _stmt->executeInterval(*_code, _slot, Eq::ivRange(a.x, b.x));
+    }
+
+    bool CurveSampler::isSameSide(const CurveSample& a, const CurveSample& b) const
+    {
+        return (a.y < _yLo && b.y < _yLo) || (a.y > _yHi && b.y > _yHi);
+    }
+
+    bool CurveSampler::isOutside(const CurveSample& a, const CurveSample& b)
+    {
+        if (!_enclose || !isSameSide(a, b))
+            return false;
+
+        const Eq::Interval y = enclose(a, b);
+        return y.hi < _yLo || y.lo > _yHi;
+    }
+
+    void CurveSampler::emit(const CurveSample& pt)
+    {
+        if (isBreak(pt))
+            emitBreak(pt.x);
+        else
+            _dest->push_back(pt);
+    }
+
+    void CurveSampler::emitBreak(const R64 x)
+    {
+        if (_dest->isNotEmpty() && !isBreak(_dest->back()))
+            _dest->push_back({x, NAN});
+    }
+
+    bool CurveSampler::isJump(const CurveSample& a, const CurveSample& b)
+    {
+        // The enclosure of the interval either has a jump,
+        // or proves that the rise between a and b is continuous.
+        if (_enclose)
+        {
+            const Eq::Interval y = enclose(a, b);
+            if (!y.continuous)
+                return true;
+            if (Eq::ivIsBounded(y))
+                return false;
+        }
+
+        // otherwise it is only continuous if the
+        // midpoint lies between the ends
+        const CurveSample m   = eval((a.x + b.x) * 0.5);
+        const R64         tol = _tolerance / _scaleY;
+
+        return isBreak(m) ||
+               m.y < Min(a.y, b.y) - tol ||
+               m.y > Max(a.y, b.y) + tol;
+    }
+
+    void CurveSampler::refine(const CurveSample& a,
+                              const CurveSample& b,
+                              const U8           depth)
+    {
+        // a has already been emitted.
+        const bool va = !isBreak(a);
+        const bool vb = !isBreak(b);
+
+        if (!va && !vb)
+        {
+            emitBreak(b.x);
+            return;
+        }
+
+        const R64 x = (a.x + b.x) * 0.5;
+
+        if (depth >= _maxDepth)
+        {
+            if (va && vb && fabs(a.y - b.y) > _yHi - _yLo && isJump(a, b))
+                emitBreak(x);
+            emit(b);
+            return;
+        }
+
+        if (va && vb && isOutside(a, b))
+        {
+            emit(b);
+            return;
+        }
+
+        const CurveSample m = eval(x);
+        if (va && vb && !isBreak(m))
+        {
+            if ((!_enclose && isOutside(a, b, m)) ||
+                fabs(m.y - (a.y + b.y) * 0.5) * _scaleY <= _tolerance)
+            {
+                emit(b);
+                return;
+            }
+        }
+
+        refine(a, m, depth + 1);
+        refine(m, b, depth + 1);
+    }
+
+    R64 CurveSampler::step(const Axis& axis) const
+    {
+        return R64(axis.x.pointByI(_step));
+    }
+
+    void CurveSampler::sample(Eq::Statement&     stmt,
+                              const Eq::Program& code,
+                              const Axis&        axis,
+                              const R64          x0,
+                              const R64          x1,
+                              const R64          yLo,
+                              const R64          yHi,
+                              CurveSamples&      dest)
+    {
+        const R64 step = CurveSampler::step(axis);
+        if (!(x1 > x0) || !(step > 0))
+            return;
+
+        _stmt    = &stmt;
+        _dest    = &dest;
+        _slot    = code.indexOf("x");
+        _code    = &stmt.specialize(code, _slot);
+        _enclose = !_code->hasSideEffects();
+        _scaleY  = R64(axis.y.pointBy(1));
+        _yLo     = yLo;
+        _yHi     = yHi;
+
+        const U32 n = U32(round((x1 - x0) / step)) + 1;
+
+        _xs.resizeFast(n);
+        _ys.resizeFast(n);
+        for (U32 i = 0; i < n; ++i)
+            _xs[i] = x0 + R64(i) * step;
+        _xs[n - 1] = x1;
+
+        // coarse pass over the whole range
+        _stmt->executeBatch(*_code, _slot, _xs.data(), _ys.data(), n);
+        _evaluations += n;
+
+        CurveSample a = coarse(0);
+        emit(a);
+
+        U32 run = 0;
+        for (U32 i = 1; i < n; ++i)
+        {
+            // a run of steps outside on one side of the view is
+            // proven with a single enclosure, or refined step by step
+            if (i > run)
+            {
+                run = i;
+                while (run < n && isSameSide(a, coarse(run)))
+                    ++run;
+
+                if (--run > i && isOutside(a, coarse(run)))
+                {
+                    for (; i < run; ++i)
+                        emit(coarse(i));
+
+                    a = coarse(run);
+                    emit(a);
+                    continue;
+                }
+            }
+
+            const CurveSample b = coarse(i);
+            refine(a, b, 0);
+            a = b;
+        }
+    }
+
+}  // namespace Jam::Editor::State
@@ -0,0 +1,188 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+#include "Equation/Program.h"
+#include "Equation/Statement.h"
+#include "Math/Axis.h"
+#include "Math/Vec2F.h"
+
+namespace Jam::Editor::State
+{
+    /**
+     * \brief A world space sample of a curve. A NaN y marks a point
+     * where the curve is undefined or broken.
+     */
+    struct CurveSample
+    {
+        R64 x;
+        R64 y;
+    };
+
+    using CurveSamples = SimpleArray<CurveSample>;
+
+    /**
+     * \brief Screen space points used to draw one connected run.
+     */
+    using Polyline = SimpleArray<Vec2F>;
+
+    /**
+     * \brief Adaptively samples a compiled expression.
+     *
+     * The curve is first evaluated on a coarse grid that is aligned to
+     * multiples of the step in world units, so separately sampled ranges
+     * join up. Each interval is then subdivided until the midpoint deviates
+     * from the chord by less than the tolerance (in pixels). Intervals where
+     * one side is undefined are bisected to locate the edge of the gap, and
+     * jumps that do not close at the finest subdivision are emitted as
+     * breaks. Intervals entirely outside of [yLo, yHi] are not refined.
+     *
+     * Pure expressions are also evaluated over whole intervals, which
+     * proves that an interval stays outside of the view, and tells a
+     * steep but continuous rise from an asymptote without probing it.
+     */
+    class CurveSampler
+    {
+    private:
+        Eq::Statement*     _stmt{nullptr};
+        const Eq::Program* _code{nullptr};
+        CurveSamples*      _dest{nullptr};
+        U32                _slot{JtNpos32};
+        R64                _scaleY{1};
+        R64                _yLo{0};
+        R64                _yHi{0};
+        Eq::ValueList      _xs;
+        Eq::ValueList      _ys;
+        R32                _tolerance{0.25f};
+        R32                _step{4.f};
+        U8                 _maxDepth{6};
+        U32                _evaluations{0};
+        bool               _enclose{false};
+
+        CurveSample eval(R64 x);
+
+        // The sample at index i of the coarse pass.
+        CurveSample coarse(U32 i) const;
+
+        Eq::Interval enclose(const CurveSample& a, const CurveSample& b);
+
+        bool isOutside(const CurveSample& a,
+                       const CurveSample& b,
+                       const CurveSample& m) const;
+
+        bool isSameSide(const CurveSample& a, const CurveSample& b) const;
+
+        // True if the enclosure of [a.x, b.x] is outside of the view.
+        bool isOutside(const CurveSample& a, const CurveSample& b);
+
+        void emit(const CurveSample& pt);
+
+        void emitBreak(R64 x);
+
+        // True if the steep rise between a and b at the
+        // finest subdivision is a break in the curve.
+        bool isJump(const CurveSample& a, const CurveSample& b);
+
+        void refine(const CurveSample& a, const CurveSample& b, U8 depth);
+
+    public:
+        CurveSampler() = default;
+
+        void setTolerance(R32 pixels);
+
+        void setStep(R32 pixels);
+
+        void setMaxDepth(U8 depth);
+
+        // Copies the tolerance, step and depth settings of other.
+        void configure(const CurveSampler& other);
+
+        /**
+         * \brief Appends the samples of [x0, x1] to dest.
+         *
+         * Both ends should lie on the grid returned by step().
+         * Samples at x0 and x1 are always emitted.
+         */
+        void sample(Eq::Statement&     stmt,
+                    const Eq::Program& code,
+                    const Axis&        axis,
+                    R64                x0,
+                    R64                x1,
+                    R64                yLo,
+                    R64                yHi,
+                    CurveSamples&      dest);
+
+        // The world width of one coarse step for the supplied axis.
+        R64 step(const Axis& axis) const;
+
+        R32 tolerance() const;
+
+        // The number of evaluations made since the last call to resetStats.
+        U32 evaluations() const;
+
+        void resetStats();
+
+        static bool isBreak(const CurveSample& pt);
+    };
+
+    inline void CurveSampler::setTolerance(const R32 pixels)
+    {
+        _tolerance = Max(pixels, 0.01f);
+    }
+
+    inline void CurveSampler::setStep(const R32 pixels)
+    {
+        _step = Max(pixels, 1.f);
+    }
+
+    inline void CurveSampler::setMaxDepth(const U8 depth)
+    {
+        _maxDepth = Min<U8>(depth, 16);
+    }
+
+    inline void CurveSampler::configure(const CurveSampler& other)
+    {
+        _tolerance = other._tolerance;
+        _step      = other._step;
+        _maxDepth  = other._maxDepth;
+    }
+
+    inline R32 CurveSampler::tolerance() const
+    {
+        return _tolerance;
+    }
+
+    inline U32 CurveSampler::evaluations() const
+    {
+        return _evaluations;
+    }
+
+    inline void CurveSampler::resetStats()
+    {
+        _evaluations = 0;
+    }
+
+    inline bool CurveSampler::isBreak(const CurveSample& pt)
+    {
+        return std::isnan(pt.y);
+    }
+
+}  // namespace Jam::Editor::State
@@ -20,60 +20,71 @@
 -------------------------------------------------------------------------------
 */
 #include "FrameStackSerialize.h"
+#include "Interface/Areas/OutputArea.h"
 #include "State/FrameStack/FunctionLayer.h"
 #include "State/ProjectManager.h"
 #include "State/ProjectTags.h"
 #include "Utils/XmlConverter.h"
 #include "Xml/Declarations.h"
-#include "Xml/File.h"
+#include "Xml/Reader.h"
+#include "Xml/Writer.h"
 
 namespace Jam::Editor::State
 {
     using Xc = XmlConverter;
-    using Sc = StringUtils;
 
     FrameStackSerialize::FrameStackSerialize(FrameStack* stack) :
         _stack{stack}
     {
     }
 
-    GridLayer* FrameStackSerialize::loadGrid(const XmlNode* root) const
+    GridLayer* FrameStackSerialize::loadGrid(XmlReader& reader)
     {
         const auto grid = new GridLayer();
         grid->setMajorGrid(0x2b2b2bFF);
         grid->setMinorGrid(0x212121FF);
         grid->setOrigin(0x4B4B4BFF);
 
-        grid->setOrigin(Xc::toVec2F("origin", root, {0.f, 0}));
-        grid->setAxis(Xc::toAxis("axis", root));
+        grid->setOrigin(Xc::toVec2F("origin", reader, {0.f, 0}));
+        grid->setAxis(Xc::toAxis("axis", reader));
+
+        reader.skip();
         return grid;
     }
 
-    FunctionLayer* FrameStackSerialize::loadFunction(const XmlNode* root)
+    FunctionLayer* FrameStackSerialize::loadFunction(XmlReader& reader)
     {
-        const auto fnc = new FunctionLayer();
+        const auto   fnc   = new FunctionLayer();
+        const size_t depth = reader.depth();
 
-        for (const auto& node : root->children())
+        while (reader.next())
         {
-            if (node->isTypeOf(ExpressionTag))
+            if (reader.event() == Xml::EventEndElement && reader.depth() == depth)
+                break;
+            if (reader.event() != Xml::EventStartElement)
+                continue;
+
+            if (reader.isTypeOf(ExpressionTag))
             {
                 ExpressionStateObject* eso = fnc->createExpression();
-                eso->setText(node->attribute("text"));
+                eso->setText(String(reader.attribute("text")));
+                if (!eso->error().empty())
+                    Log::writeLine(eso->error());
             }
-            else if (node->isTypeOf(VariableTag))
+            else if (reader.isTypeOf(VariableTag))
             {
                 VariableStateObject* vso = fnc->createVariable();
 
-
-                vso->setName(node->attribute("name"));
-                vso->setRange(Xc::toVec2F("range", node, {-10.f, 10}));
-                vso->setRate(node->float32("rate", 1));
-                vso->setValue(node->float32("value", 1));
+                vso->setName(String(reader.attribute("name")));
+                vso->setRange(Xc::toVec2F("range", reader, {-10.f, 10}));
+                vso->setRate(reader.float32("rate", 1));
+                vso->setValue(reader.float32("value", 1));
             }
             else
             {
                 // quiet error
             }
+            reader.skip();
         }
 
         return fnc;
@@ -81,34 +92,55 @@ namespace Jam::Editor::State
 
     void FrameStackSerialize::load(IStream& stream) const
     {
-        try
+        XmlReader reader(FrameStackTags,
+                         FrameStackTagsMax);
+        reader.read(stream);
+
+        // the stack is the root element here
+        while (reader.next())
         {
-            XmlFile fp(FrameStackTags,
-                       FrameStackTagsMax);
-            fp.read(stream);
+            if (reader.event() == Xml::EventStartElement)
+                break;
+        }
+        load(reader);
+    }
 
+    void FrameStackSerialize::load(XmlReader& reader) const
+    {
+        try
+        {
+            // The stack is read as a stream, so the state objects
+            // are built without a tree of the whole file.
             GridLayer*     grid = nullptr;
             FunctionLayer* func = nullptr;
 
-            if (const auto root = fp.root(FrameStackTag))
+            const bool   found = reader.event() == Xml::EventStartElement &&
+                                 reader.isTypeOf(FrameStackTag);
+            const size_t depth = reader.depth();
+
+            while (found && reader.next())
             {
-                for (const auto node : root->children())
+                if (reader.event() == Xml::EventEndElement && reader.depth() == depth)
+                    break;
+                if (reader.event() != Xml::EventStartElement)
+                    continue;
+
+                if (reader.isTypeOf(GridTag))
                 {
-                    if (node->isTypeOf(GridTag))
-                    {
-                        if (grid)
-                            throw Exception("multiple grid layers");
-
-                        grid = loadGrid(node);
-                    }
-                    else if (node->isTypeOf(FunctionTag))
-                    {
-                        if (func)
-                            throw Exception("multiple function layers");
-
-                        func = loadFunction(node);
-                    }
+                    if (grid)
+                        throw Exception("multiple grid layers");
+
+                    grid = loadGrid(reader);
                 }
+                else if (reader.isTypeOf(FunctionTag))
+                {
+                    if (func)
+                        throw Exception("multiple function layers");
+
+                    func = loadFunction(reader);
+                }
+                else
+                    reader.skip();
             }
 
             // order here is important
@@ -129,34 +161,30 @@ namespace Jam::Editor::State
         }
     }
 
-    void FrameStackSerialize::saveGrid() const
+    void FrameStackSerialize::saveGrid(XmlWriter& writer) const
     {
         const auto layer = _stack->cast<GridLayer>(0);
 
         const Vec2F& o  = layer->origin();
         const Axis&  ax = layer->axis();
 
-        XmlNode* grid = new XmlNode("grid", GridTag);
-
-        grid->insert("origin",
-                     Sc::join(ValueSetF({o.x, o.y}, 0, 6)));
-
-        grid->insert("axis",
-                     Sc::join(ValueSetU({
-                         ax.x.n(),
-                         ax.x.d(),
-                         ax.y.n(),
-                         ax.y.d(),
-                     })));
-
-        _root->addChild(grid);
+        writer.beginElement("grid");
+        writer.attribute("origin", {o.x, o.y});
+        writer.attribute("axis",
+                         {
+                             ax.x.n(),
+                             ax.x.d(),
+                             ax.y.n(),
+                             ax.y.d(),
+                         });
+        writer.endElement();
     }
 
-    void FrameStackSerialize::saveFunction() const
+    void FrameStackSerialize::saveFunction(XmlWriter& writer) const
     {
         const auto layer = _stack->cast<FunctionLayer>(1);
 
-        XmlNode* func = new XmlNode("function", FunctionTag);
+        writer.beginElement("function");
 
         for (const auto id : layer->objects())
         {
@@ -164,35 +192,34 @@ namespace Jam::Editor::State
             {
                 const ExpressionStateObject* eso = (ExpressionStateObject*)id;
 
-                XmlNode* expr = new XmlNode("expression", ExpressionTag);
-                expr->insert("text", eso->text());
-                func->addChild(expr);
+                writer.beginElement("expression");
+                writer.attribute("text", eso->text());
+                writer.endElement();
             }
             else if (id->type() == FstVariable)
             {
                 const VariableStateObject* vso = (VariableStateObject*)id;
 
-                XmlNode* expr = new XmlNode("variable", VariableTag);
-                expr->insert("name", vso->name());
-                expr->insert("range",
-                             Sc::join(ValueSetF({vso->range().x, vso->range().y}, 0, 6)));
-                expr->insert("rate",
-                             Sc::join(FloatPrint(vso->rate())));
-                expr->insert("value",
-                             Sc::join(FloatPrint(vso->value())));
-                func->addChild(expr);
+                writer.beginElement("variable");
+                writer.attribute("name", vso->name());
+                writer.attribute("range", {vso->range().x, vso->range().y});
+                writer.attribute("rate", vso->rate());
+                writer.attribute("value", vso->value());
+                writer.endElement();
             }
         }
-        _root->addChild(func);
+        writer.endElement();
     }
 
-    void FrameStackSerialize::save(OStream& out)
+    void FrameStackSerialize::save(OStream& out) const
     {
-        _root = new XmlNode("stack", FrameStackTag);
-        saveGrid();
-        saveFunction();
-        Xc::toStream(out, _root, 4);
-        delete _root;
-        _root = nullptr;
+        XmlWriter writer;
+        Xc::configure(writer, 4);
+
+        writer.begin(out);
+        writer.beginElement("stack");
+        saveGrid(writer);
+        saveFunction(writer);
+        writer.end();
     }
 }  // namespace Jam::Editor::State
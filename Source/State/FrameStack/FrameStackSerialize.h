@@ -29,20 +29,25 @@ namespace Jam::Editor::State
     {
     private:
         FrameStack* _stack{nullptr};
-        XmlNode*    _root{nullptr};  // only valid on save
 
     private:
-        GridLayer*            loadGrid(const XmlNode* root) const;
-        static FunctionLayer* loadFunction(const XmlNode* root);
+        static GridLayer*     loadGrid(XmlReader& reader);
+        static FunctionLayer* loadFunction(XmlReader& reader);
 
-        void saveGrid() const;
-        void saveFunction() const;
+        void saveGrid(XmlWriter& writer) const;
+        void saveFunction(XmlWriter& writer) const;
 
     public:
         explicit FrameStackSerialize(FrameStack* stack);
 
         void load(IStream& stream) const;
-        void save(OStream& out);
+
+        // Reads the stack element the reader is on. The reader only
+        // needs type codes from FrameStackTags, so any filter that
+        // includes them (ProjectFileTags) works.
+        void load(XmlReader& reader) const;
+
+        void save(OStream& out) const;
     };
 
 }  // namespace Jam::Editor::State
@@ -46,51 +46,77 @@ namespace Jam::Editor::State
         canvas.drawVec2F(20, 20, toVec2F(_size), 0);
         canvas.drawAxisF(20, 40, _axis);
 
-        for (I32 i0 = 1; i0 < _size.x; ++i0)
-            renderExpression(canvas, i0);
-    }
+        // the visible range in world units
+        const R64 x0 = _axis.x.pointByI(-_origin.x);
+        const R64 x1 = _axis.x.pointByI(_size.rx() - _origin.x);
+        const R64 y0 = _axis.y.pointByI(-_origin.y);
+        const R64 y1 = _axis.y.pointByI(_size.ry() - _origin.y);
+
+        // Assignments run once here, in order, so a value such as
+        // a = 2 reaches the expressions that read a. Each task copies
+        // the inputs of its program from this statement.
+        for (const auto obj : _expr)
+        {
+            const Eq::Program& code = ((ExpressionStateObject*)obj)->program();
+            if (code.hasSideEffects())
+                (void)_stmt.execute(code);
+        }
 
-    void FunctionLayer::renderExpression(RenderContext& canvas, I32 i0)
-    {
+        // collect the missing ranges of every expression, then sample
+        // them across the pool before stitching them back in order
+        _tasks.clear();
+        _counts.resizeFast(0);
         for (const auto obj : _expr)
         {
-            const ExpressionStateObject* vso = (ExpressionStateObject*)obj;
+            ExpressionStateObject* eso = (ExpressionStateObject*)obj;
+            _counts.push_back(eso->cache().prepare(_sampler,
+                                                   _stmt,
+                                                   eso->program(),
+                                                   _axis,
+                                                   x0,
+                                                   x1,
+                                                   y0,
+                                                   y1,
+                                                   _tasks,
+                                                   SampleChunk));
+        }
 
-            const Vec2F a = eval(R32(i0 - 1), vso->symbols());
-            const Vec2F b = eval(R32(i0), vso->symbols());
+        SamplerPool::shared().run(_sampler, _axis, _tasks.data(), (U32)_tasks.size());
 
-            if (abs(a.y - b.y) <= _size.ry())
-            {
-                canvas.selectColor(Blue04, 2);
-                canvas.drawLine(a.x, a.y, b.x, b.y);
-            }
-            else
-            {
-                const Vec2F c = eval(R32(i0 - 1) + Half, vso->symbols());
-
-                if (isnan(c.y) && !isnan(b.y))
-                {
-                    canvas.selectColor(Green04, 2);
-                    const R32 yV = sign(a.x) * (_size.ry() + 3);
-                    canvas.drawLine(a.x, yV, b.x, b.y);
-                }
-            }
+        const SampleTask* tasks = _tasks.data();
+        for (U32 i = 0; i < _expr.size(); ++i)
+        {
+            ExpressionStateObject* eso = (ExpressionStateObject*)_expr[i];
+
+            renderSamples(canvas, eso->cache().commit(tasks, _counts[i]));
+            tasks += _counts[i];
         }
     }
 
-    Vec2F FunctionLayer::eval(const R32 i0, const Eq::SymbolArray& code)
+    void FunctionLayer::renderSamples(RenderContext&      canvas,
+                                      const CurveSamples& samples)
     {
-        Vec2F p0{i0 - R32(_origin.ix()), 0.f};
-        if (!code.empty())
+        const R32 h = _size.ry();
+
+        canvas.selectColor(Blue04, 2);
+
+        // project and draw each connected run of the curve
+        _polyline.resizeFast(0);
+        for (U32 i = 0; i <= samples.size(); ++i)
         {
-            _stmt.set("x", R64(_axis.x.pointByI(p0.x)));
-            p0.y = _axis.y.pointBy(R32(_stmt.execute(code)));
-        }
+            if (i == samples.size() || CurveSampler::isBreak(samples[i]))
+            {
+                canvas.drawPolyline(_polyline.data(), _polyline.size());
+                _polyline.resizeFast(0);
+                continue;
+            }
 
-        p0.x += _origin.x;
-        p0.y += _origin.y;
-        p0.y = _size.ry() - p0.y;
-        return p0;
+            const CurveSample& pt = samples[i];
+
+            const R32 sy = _axis.y.pointBy(R32(pt.y)) + _origin.y;
+            _polyline.push_back(Vec2F(_axis.x.pointBy(R32(pt.x)) + _origin.x,
+                                      h - Clamp(sy, -h, h + h)));
+        }
     }
 
     bool FunctionLayer::resizeEvent(const Vec2I&)
@@ -149,16 +175,26 @@ namespace Jam::Editor::State
     VariableStateObject* FunctionLayer::createVariable()
     {
         VariableStateObject* vso = new VariableStateObject();
-        _array.push_back(vso);
+        addVariable(vso);
         return vso;
     }
 
     ExpressionStateObject* FunctionLayer::createExpression()
     {
         ExpressionStateObject* eso = new ExpressionStateObject();
+        addExpression(eso);
+        return eso;
+    }
+
+    void FunctionLayer::addVariable(VariableStateObject* vso)
+    {
+        _array.push_back(vso);
+    }
+
+    void FunctionLayer::addExpression(ExpressionStateObject* eso)
+    {
         _expr.push_back(eso);
         _array.push_back(eso);
-        return eso;
     }
 
     void FunctionLayer::removeVariable(VariableStateObject* vso)
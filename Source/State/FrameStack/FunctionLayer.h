@@ -21,9 +21,11 @@
 */
 #pragma once
 #include "BaseLayer.h"
+#include "CurveSampler.h"
 #include "Equation/Statement.h"
 #include "Equation/StmtParser.h"
 #include "FunctionStateObject.h"
+#include "SamplerPool.h"
 #include "State/FrameStack/GridLayer.h"
 
 namespace Jam::Editor::State
@@ -31,25 +33,28 @@ namespace Jam::Editor::State
     class FunctionLayer final : public BaseLayer
     {
     private:
-        Vec2F          _origin{0.f, 0.f};
-        Axis           _axis;
-        Eq::StmtParser _parser;
-        Eq::Statement  _stmt;
-        VInt           _xLoc{JtNpos};
-        String         _text;
+        Vec2F            _origin{0.f, 0.f};
+        Axis             _axis;
+        Eq::StmtParser   _parser;
+        Eq::Statement    _stmt;
+        VInt             _xLoc{JtNpos};
+        String           _text;
+        CurveSampler     _sampler;
+        SampleTasks      _tasks;
+        SimpleArray<U32> _counts;
+        Polyline         _polyline;
 
         FunctionObjectArray _array;
         FunctionObjectArray _expr;
 
-        Vec2F eval(R32 i0, const Eq::SymbolArray& sym);
-
         bool resizeEvent(const Vec2I& oldSize) override;
 
         bool injectVec2FImpl(const FrameStackCode& code,
                              const Vec2F&          size) override;
 
         void render(RenderContext& canvas) override;
-        void renderExpression(RenderContext& canvas, I32 i0);
+        void renderSamples(RenderContext&      canvas,
+                           const CurveSamples& samples);
 
     public:
         FunctionLayer();
@@ -59,6 +64,8 @@ namespace Jam::Editor::State
 
         void setOrigin(const Vec2F& origin);
 
+        void setTolerance(R32 pixels);
+
         const String& getText() const;
 
         bool update() override;
@@ -66,6 +73,10 @@ namespace Jam::Editor::State
         VariableStateObject*   createVariable();
         ExpressionStateObject* createExpression();
 
+        // Takes ownership of an object made outside the layer.
+        void addVariable(VariableStateObject* vso);
+        void addExpression(ExpressionStateObject* eso);
+
         void removeVariable(VariableStateObject* vso);
         void removeExpression(ExpressionStateObject* eso);
 
@@ -82,6 +93,11 @@ namespace Jam::Editor::State
         _origin = origin;
     }
 
+    inline void FunctionLayer::setTolerance(const R32 pixels)
+    {
+        _sampler.setTolerance(pixels);
+    }
+
     inline const FunctionObjectArray& FunctionLayer::objects() const
     {
         return _array;
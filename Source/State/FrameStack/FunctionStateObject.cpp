@@ -21,30 +21,65 @@
 */
 #include "FunctionStateObject.h"
 #include "Equation/StmtParser.h"
-#include "Interface/Areas/OutputArea.h"
 
 namespace Jam::Editor::State
 {
     void ExpressionStateObject::setText(const String& text)
     {
+        // repeating text that failed is a no-op, so it
+        // is not parsed again on every preview
+        if (!_error.empty() && text == _text)
+            return;
+
         _text = text;
         try
         {
-            StringStream ss(_text);
-            _parser.read(ss);
+            // edits that keep the same tokens, such as spacing,
+            // keep the compiled program and the sampled curve
+            _parser.tokenize(_text, _next);
+            if (_next == _tokens)
+                return;
+        }
+        catch (Exception& ex)
+        {
+            _tokens.clear();
+            _cache.invalidate();
+            _program.clear();
+            _error = ex.what();
+            return;
+        }
 
-            ss.str(String{});
-            ss.clear();
-            for (const auto sym : _parser.symbols())
+        // the key is kept on failure too, so an edit that
+        // only changes spacing of broken text is skipped
+        _tokens.swap(_next);
+        _cache.invalidate();
+        _error.clear();
+
+        try
+        {
+            _parser.readText(_text);
+
+            // a program that fails to compile is left empty
+            // and is sampled as zero
+            if (!_program.tryCompile(_parser.symbols()))
             {
-                sym->print(ss);
-                ss << ' ';
+                _error = _program.error();
+                return;
             }
-            Log::writeLine(ss.str());
         }
-        catch (Exception &ex)
+        catch (Exception& ex)
+        {
+            _program.clear();
+            _error = ex.what();
+        }
+    }
+
+    void ExpressionStateObject::printSymbols(OStream& out) const
+    {
+        for (const auto sym : _parser.symbols())
         {
-            Log::writeLine(ex.what());
+            sym->print(out);
+            out << ' ';
         }
     }
 
@@ -20,7 +20,9 @@
 -------------------------------------------------------------------------------
 */
 #pragma once
+#include "Equation/Program.h"
 #include "Equation/StmtParser.h"
+#include "State/FrameStack/CurveCache.h"
 #include "State/FrameStack/GridLayer.h"
 
 namespace Jam::Editor::State
@@ -76,7 +78,12 @@ namespace Jam::Editor::State
     {
     private:
         String         _text{};
+        String         _tokens{};
+        String         _next{};
+        String         _error{};
         Eq::StmtParser _parser;
+        Eq::Program    _program;
+        CurveCache     _cache;
 
     public:
         explicit ExpressionStateObject() :
@@ -87,7 +94,26 @@ namespace Jam::Editor::State
 
         const Eq::SymbolArray& symbols() const { return _parser.symbols(); }
 
+        const Eq::Program& program() const { return _program; }
+
+        CurveCache& cache() { return _cache; }
+
+        // The parse or compile error of the current text, if any.
+        const String& error() const { return _error; }
+
+        /**
+         * \brief Recompiles the expression when the tokens of text
+         * differ from the current ones. This is cheap enough to be
+         * called while the text is being typed.
+         *
+         * Errors are kept in error() rather than logged, so the caller
+         * decides when they are worth reporting. Nothing is written to
+         * the log here, since this can run on the render thread.
+         */
         void setText(const String& text);
+
+        // Writes the postfix symbols of the current text to out.
+        void printSymbols(OStream& out) const;
     };
 
 }  // namespace Jam::Editor::State
\ No newline at end of file
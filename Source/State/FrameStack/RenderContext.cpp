@@ -119,6 +119,19 @@ namespace Jam::Editor::State
             QPointF{qreal(x2 + o.x), qreal(y2 + o.y)});
     }
 
+    void RenderContext::drawPolyline(const Vec2F* points, const U32 count)
+    {
+        if (isNotValid() || !points || count < 2)
+            return;
+
+        _points.resizeFast(0);
+        _points.reserve(count);
+        for (U32 i = 0; i < count; ++i)
+            _points.push_back(QPointF{qreal(points[i].x), qreal(points[i].y)});
+
+        _painter->drawPolyline(_points.data(), _points.sizeI());
+    }
+
     void RenderContext::drawPoint(int x0, int y0) const
     {
         if (isNotValid())
@@ -28,7 +28,8 @@
 
 namespace Jam::Editor::State
 {
-    using LineBuffer = SimpleArray<QLineF>;
+    using LineBuffer  = SimpleArray<QLineF>;
+    using PointBuffer = SimpleArray<QPointF>;
 
     class RenderContext
     {
@@ -43,6 +44,8 @@ namespace Jam::Editor::State
         LineBuffer _minor;
         LineBuffer _center;
 
+        PointBuffer _points;
+
         void stepGrid(R32          x1,
                       R32          y1,
                       R32          x2,
@@ -84,6 +87,8 @@ namespace Jam::Editor::State
 
         void drawLine(R32 x1, R32 y1, R32 x2, R32 y2) const;
 
+        void drawPolyline(const Vec2F* points, U32 count);
+
         void drawPoint(int x0, int y0) const;
 
         void drawPoint(int x0, int y0, int scale) const;
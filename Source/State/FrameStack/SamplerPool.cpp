@@ -0,0 +1,126 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "State/FrameStack/SamplerPool.h"
+
+namespace Jam::Editor::State
+{
+    SamplerPool::SamplerPool(U32 threads)
+    {
+        if (threads == 0)
+            threads = Max<U32>(std::thread::hardware_concurrency(), 1);
+
+        for (U32 i = 0; i < threads; ++i)
+            _workers.push_back(std::make_unique<Worker>());
+
+        // worker zero belongs to the thread that calls run
+        for (U32 i = 1; i < threads; ++i)
+            _threads.emplace_back(&SamplerPool::main, this, i);
+    }
+
+    SamplerPool::~SamplerPool()
+    {
+        {
+            std::lock_guard lock(_mutex);
+            _quit = true;
+        }
+        _wake.notify_all();
+
+        for (std::thread& thread : _threads)
+            thread.join();
+    }
+
+    SamplerPool& SamplerPool::shared()
+    {
+        static SamplerPool pool;
+        return pool;
+    }
+
+    void SamplerPool::drain(Worker& worker)
+    {
+        for (U32 i = _next++; i < _count; i = _next++)
+            CurveCache::sample(worker.sampler, worker.stmt, *_axis, _tasks[i]);
+    }
+
+    void SamplerPool::main(const U32 index)
+    {
+        Worker& worker = *_workers[index];
+        U64     seen   = 0;
+
+        for (;;)
+        {
+            {
+                std::unique_lock lock(_mutex);
+                _wake.wait(lock, [&] { return _quit || _generation != seen; });
+                if (_quit)
+                    return;
+                seen = _generation;
+            }
+
+            drain(worker);
+
+            {
+                std::lock_guard lock(_mutex);
+                if (--_busy == 0)
+                    _idle.notify_one();
+            }
+        }
+    }
+
+    void SamplerPool::run(const CurveSampler& sampler,
+                          const Axis&         axis,
+                          SampleTask*         tasks,
+                          const U32           count)
+    {
+        if (count == 0)
+            return;
+
+        const std::lock_guard running(_running);
+
+        // the workers are idle between runs
+        for (const auto& worker : _workers)
+            worker->sampler.configure(sampler);
+
+        _axis  = &axis;
+        _tasks = tasks;
+        _count = count;
+        _next  = 0;
+
+        if (count == 1 || _threads.empty())
+        {
+            drain(*_workers[0]);
+            return;
+        }
+
+        {
+            std::lock_guard lock(_mutex);
+            _busy = (U32)_threads.size();
+            ++_generation;
+        }
+        _wake.notify_all();
+
+        drain(*_workers[0]);
+
+        std::unique_lock lock(_mutex);
+        _idle.wait(lock, [this] { return _busy == 0; });
+    }
+
+}  // namespace Jam::Editor::State
@@ -0,0 +1,106 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "State/FrameStack/CurveCache.h"
+
+namespace Jam::Editor::State
+{
+    // The number of grid steps sampled by one task.
+    constexpr U32 SampleChunk = 64;
+
+    /**
+     * \brief A fixed set of threads that sample tasks in parallel.
+     *
+     * Every worker owns its own statement and sampler, so tasks never
+     * share evaluation state. The calling thread takes part in run and
+     * returns once every task has been sampled.
+     *
+     * Layers sample through the process wide shared() pool, so the
+     * thread count does not grow with the number of layers.
+     */
+    class SamplerPool
+    {
+    private:
+        struct Worker
+        {
+            Eq::Statement stmt;
+            CurveSampler  sampler;
+        };
+
+        using WorkerArray = std::vector<std::unique_ptr<Worker>>;
+        using ThreadArray = std::vector<std::thread>;
+
+        WorkerArray             _workers;
+        ThreadArray             _threads;
+        std::mutex              _mutex;
+        std::mutex              _running;
+        std::condition_variable _wake;
+        std::condition_variable _idle;
+        std::atomic<U32>        _next{0};
+        SampleTask*             _tasks{nullptr};
+        U32                     _count{0};
+        U32                     _busy{0};
+        U64                     _generation{0};
+        const Axis*             _axis{nullptr};
+        bool                    _quit{false};
+
+        void main(U32 index);
+
+        void drain(Worker& worker);
+
+    public:
+        /**
+         * \brief Starts the worker threads.
+         * \param threads The total number of threads including the caller.
+         * Zero uses the number of hardware threads.
+         */
+        explicit SamplerPool(U32 threads = 0);
+
+        ~SamplerPool();
+
+        // The pool started on first use, sized by the hardware threads.
+        static SamplerPool& shared();
+
+        /**
+         * \brief Samples count tasks with the settings of sampler.
+         * Calls from different threads take turns.
+         */
+        void run(const CurveSampler& sampler,
+                 const Axis&         axis,
+                 SampleTask*         tasks,
+                 U32                 count);
+
+        // The total number of threads including the caller.
+        U32 size() const;
+    };
+
+    inline U32 SamplerPool::size() const
+    {
+        return (U32)_workers.size();
+    }
+
+}  // namespace Jam::Editor::State
@@ -21,16 +21,32 @@
 */
 #include "FrameStackManager.h"
 #include "FrameStack/FrameStack.h"
+#include "Interface/Areas/OutputArea.h"
 
 namespace Jam::Editor::State
 {
     FrameStackManager::FrameStackManager()
     {
         _stack = new FrameStack();
+
+        // posted edits can run on the render thread, so
+        // their errors are logged from this one
+        connect(
+            this,
+            &FrameStackManager::editFailed,
+            this,
+            [](const QString& message)
+            { Log::writeLine(message.toStdString()); },
+            Qt::QueuedConnection);
     }
 
     FrameStackManager::~FrameStackManager()
     {
+        // A render thread that has not stopped yet can still be in
+        // render. Taking the lock also applies the pending edits, which
+        // can own objects that are not in a layer yet.
+        const auto guard = lock();
+
         delete _stack;
         _stack = nullptr;
     }
@@ -39,6 +55,7 @@ namespace Jam::Editor::State
     {
         if (_stack)
         {
+            const auto guard = lock();
             _stack->clear();
         }
     }
@@ -46,7 +63,40 @@ namespace Jam::Editor::State
     void FrameStackManager::load(IStream& data) const
     {
         if (_stack)
+        {
+            const auto guard = lock();
             _stack->serialize(data);
+        }
+    }
+
+    void FrameStackManager::applyPending() const
+    {
+        {
+            std::lock_guard guard(_pendingMutex);
+            for (const PendingVec2& it : _pending)
+                _applying.push_back(it);
+            _pending.resizeFast(0);
+
+            // anything left by an edit that threw is dropped
+            _editing.clear();
+            _editing.swap(_edits);
+        }
+
+        for (const PendingVec2& it : _applying)
+            (void)_stack->injectVec2(it.code, it.value);
+        _applying.resizeFast(0);
+
+        for (const PendingEdit& edit : _editing)
+            edit();
+        _editing.clear();
+    }
+
+    std::unique_lock<std::mutex> FrameStackManager::lock() const
+    {
+        std::unique_lock guard(_mutex);
+        if (_stack)
+            applyPending();
+        return guard;
     }
 
     bool FrameStackManager::injectVec2(
@@ -56,7 +106,11 @@ namespace Jam::Editor::State
         bool result = false;
         if (_stack)
         {
-            result = _stack->injectVec2(code, value);
+            {
+                // keeps the order of anything posted before this call
+                const auto guard = lock();
+                result = _stack->injectVec2(code, value);
+            }
             if (result)
                 emit vec2Injected(code, value);
             emit stateChanged();
@@ -64,12 +118,52 @@ namespace Jam::Editor::State
         return result;
     }
 
+    void FrameStackManager::post(
+        const FrameStackCode& code,
+        const Vec2F&          value) const
+    {
+        if (_stack)
+        {
+            {
+                std::lock_guard guard(_pendingMutex);
+                _pending.push_back({code, value});
+            }
+            emit vec2Injected(code, value);
+            emit stateChanged();
+        }
+    }
+
+    void FrameStackManager::post(PendingEdit&& edit) const
+    {
+        if (_stack)
+        {
+            {
+                std::lock_guard guard(_pendingMutex);
+                _edits.push_back(std::move(edit));
+            }
+
+            // without a frame in progress there is no reason to wait
+            if (const std::unique_lock guard(_mutex, std::try_to_lock);
+                guard.owns_lock())
+                applyPending();
+        }
+    }
+
+    void FrameStackManager::reportError(const String& message) const
+    {
+        emit editFailed(QString::fromStdString(message));
+    }
+
     void FrameStackManager::addLayer(BaseLayer* layer) const
     {
         if (_stack)
         {
-            if (const U32 id = _stack->addLayer(layer);
-                id != JtNpos32)
+            U32 id;
+            {
+                const auto guard = lock();
+                id = _stack->addLayer(layer);
+            }
+            if (id != JtNpos32)
                 emit layerAdded(layer->type, id);
         }
     }
@@ -89,7 +183,12 @@ namespace Jam::Editor::State
     void FrameStackManager::render(RenderContext* canvas) const
     {
         if (_stack && canvas)
-            _stack->render(canvas);
+        {
+            // the stack is released under the lock
+            const auto guard = lock();
+            if (_stack)
+                _stack->render(canvas);
+        }
     }
 
 }  // namespace Jam::Editor::State
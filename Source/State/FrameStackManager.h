@@ -21,11 +21,24 @@
 */
 #pragma once
 #include <QObject>
+#include <functional>
+#include <mutex>
+#include <vector>
 #include "FrameStack/BaseLayer.h"
 #include "FrameStack/FrameStack.h"
 
 namespace Jam::Editor::State
 {
+    struct PendingVec2
+    {
+        FrameStackCode code;
+        Vec2F          value;
+    };
+
+    using PendingArray = SimpleArray<PendingVec2>;
+    using PendingEdit  = std::function<void()>;
+    using PendingEdits = std::vector<PendingEdit>;
+
     class FrameStackManager final : public QObject
     {
     public:
@@ -38,6 +51,8 @@ namespace Jam::Editor::State
 
         void layerAdded(const I32& type, const U32& index) const;
 
+        void editFailed(const QString& message) const;
+
     private:
         // This is a friend so that only ApplicationState may
         // instance this class. (do not access class members
@@ -47,6 +62,18 @@ namespace Jam::Editor::State
         FrameStack*  _stack{nullptr};
         mutable bool _error{false};
 
+        // Guards the stack against the render thread.
+        mutable std::mutex _mutex;
+
+        // Guards the changes that are waiting for the next frame.
+        mutable std::mutex   _pendingMutex;
+        mutable PendingArray _pending;
+        mutable PendingArray _applying;
+        mutable PendingEdits _edits;
+        mutable PendingEdits _editing;
+
+        void applyPending() const;
+
         FrameStackManager();
 
         ~FrameStackManager() override;
@@ -61,6 +88,36 @@ namespace Jam::Editor::State
         bool injectVec2(const FrameStackCode& code,
                         const Vec2F&          value) const;
 
+        /**
+         * \brief Queues a view change that is applied by the next call
+         * to render, so the caller never waits on a frame in progress.
+         */
+        void post(const FrameStackCode& code,
+                  const Vec2F&          value) const;
+
+        /**
+         * \brief Queues an edit of the layers or state objects. It runs
+         * now if no frame is in progress, otherwise at the start of the
+         * next one, so the caller never waits on a frame.
+         *
+         * The edit may run on the render thread. Anything it captures
+         * must outlive the edit, and errors or other log output go
+         * through reportError.
+         */
+        void post(PendingEdit&& edit) const;
+
+        /**
+         * \brief Writes message to the log from the GUI thread.
+         */
+        void reportError(const String& message) const;
+
+        /**
+         * \brief Locks the stack for the duration of the returned guard,
+         * after applying anything that was posted before the call.
+         * Hold it while modifying layers or state objects directly.
+         */
+        std::unique_lock<std::mutex> lock() const;
+
         void addLayer(BaseLayer* layer) const;
 
         void notifyStateChange() const;
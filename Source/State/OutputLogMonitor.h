@@ -42,6 +42,7 @@ namespace Jam::Editor::State
         QFileSystemWatcher* _watcher{nullptr};
         QString             _logName;
         QString*            _text{nullptr};
+        bool                _verbose{false};
 
         OutputLogMonitor();
         OutputLogMonitor(const OutputLogMonitor&);
@@ -61,6 +62,21 @@ namespace Jam::Editor::State
         void write(const QString& message) const;
 
         void clear() const;
+
+        // Enables diagnostic output that is too costly to write by default.
+        void setVerbose(bool v);
+
+        bool isVerbose() const;
     };
 
+    inline void OutputLogMonitor::setVerbose(const bool v)
+    {
+        _verbose = v;
+    }
+
+    inline bool OutputLogMonitor::isVerbose() const
+    {
+        return _verbose;
+    }
+
 }  // namespace Jam::Editor::State
@@ -25,9 +25,10 @@
 #include "FrameStackManager.h"
 #include "Interface/Areas/OutputArea.h"
 #include "State/ProjectTags.h"
+#include "Utils/MappedFile.h"
 #include "Xml/Declarations.h"
 #include "Xml/File.h"
-#include "Xml/Writer.h"
+#include "Xml/Reader.h"
 
 namespace Jam::Editor::State
 {
@@ -36,40 +37,72 @@ namespace Jam::Editor::State
         clearProjectState();
     }
 
+    ProjectManager::~ProjectManager()
+    {
+        releaseLayout();
+    }
+
     void ProjectManager::handleIoException(const Exception& ex)
     {
         qDebug(ex.what());
         unload();
     }
 
-    bool ProjectManager::loadImpl(const String& projectPath, IStream& stream)
+    bool ProjectManager::loadImpl(const String& projectPath)
     {
         // on success _path == projectPath
 
-        XmlFile psr(ProjectFileTags, ProjectFileTagsMax);
-        psr.read(stream, projectPath);
+        MappedFile file;
+        if (!file.open(projectPath))
+            throw Exception("Failed to open the project file '", projectPath, "'");
+
+        XmlReader reader(ProjectFileTags, ProjectFileTagsMax);
+        reader.readText(file.view(), projectPath);
+
+        while (reader.next())
+        {
+            if (reader.event() == Xml::EventStartElement)
+                break;
+        }
 
         bool status = false;
 
-        if (const XmlNode* jam = psr.root(JamProjectTag))
+        if (reader.event() == Xml::EventStartElement &&
+            reader.isTypeOf(JamProjectTag))
         {
             clearProjectState();
 
-            if (const XmlNode* mainLayout = jam->firstChildOf(TreeTag))
+            // the stack is streamed straight into its layers
+            while (reader.next())
             {
-                Xml::Writer::toString(_layout, mainLayout);
-                if (!_layout.empty())
-                    status = true;
+                if (reader.event() != Xml::EventStartElement)
+                    continue;
+
+                if (reader.depth() == 2 && reader.isTypeOf(FrameStackTag))
+                {
+                    const auto guard = layerStack()->lock();
+
+                    const FrameStackSerialize serialize(
+                        layerStack()->stack());
+                    serialize.load(reader);
+                    break;
+                }
+                reader.skip();
             }
 
-            if (const XmlNode* stack = jam->firstChildOf(FrameStackTag))
-            {
-                StringStream ss;
-                Xml::Writer::toStream(ss, stack);
+            // only the layout is kept as nodes, since the main
+            // area is built from them after the load
+            XmlFile psr(ProjectLayoutTags, ProjectLayoutTagsMax);
+            psr.readText(file.view(), projectPath);
 
-                const FrameStackSerialize serialize(
-                    layerStack()->stack());
-                serialize.load(ss);
+            if (const XmlNode* jam = psr.root(JamProjectTag))
+            {
+                if (const XmlNode* mainLayout = jam->firstChildOf(TreeTag))
+                {
+                    _document = psr.detachRoot();
+                    _layout   = mainLayout;
+                    status    = true;
+                }
             }
         }
 
@@ -89,8 +122,12 @@ namespace Jam::Editor::State
             out << "<jam>" << std::endl;
             out << layout;
 
-            FrameStackSerialize serialize(layerStack()->stack());
-            serialize.save(out);
+            {
+                const auto guard = layerStack()->lock();
+
+                FrameStackSerialize serialize(layerStack()->stack());
+                serialize.save(out);
+            }
 
             // XmlProject::saveFrameStack(stream);
             out << "</jam>" << std::endl;
@@ -109,8 +146,8 @@ namespace Jam::Editor::State
 
     void ProjectManager::clearProjectState()
     {
-        _path   = {};
-        _layout = {};
+        _path = {};
+        releaseLayout();
 
         if (const auto stack = layerStack())
         {
@@ -124,11 +161,11 @@ namespace Jam::Editor::State
         clearProjectState();
     }
 
-    String ProjectManager::layout() const
+    void ProjectManager::releaseLayout()
     {
-        String copy = _layout;
-        _layout     = {};
-        return copy;
+        delete _document;
+        _document = nullptr;
+        _layout   = nullptr;
     }
 
     bool ProjectManager::saveAs(const String& path,
@@ -149,8 +186,7 @@ namespace Jam::Editor::State
     {
         try
         {
-            InputFileStream stream(projectPath);
-            return loadImpl(projectPath, stream);
+            return loadImpl(projectPath);
         }
         catch (Exception& ex)
         {
@@ -22,6 +22,7 @@
 #pragma once
 #include "Utils/Exception.h"
 #include "Utils/String.h"
+#include "Xml/Declarations.h"
 
 namespace Jam
 {
@@ -39,16 +40,17 @@ namespace Jam::Editor::State
         friend class App;
 
         String         _path{};
-        mutable String _layout{};
+        XmlNode*       _document{nullptr};
+        const XmlNode* _layout{nullptr};
 
         ProjectManager();
-        ProjectManager(const ProjectManager&) = default;
+        ProjectManager(const ProjectManager&) = delete;
 
-        ~ProjectManager() = default;
+        ~ProjectManager();
 
         void handleIoException(const Exception& ex);
 
-        bool loadImpl(const String& projectPath, IStream& stream);
+        bool loadImpl(const String& projectPath);
 
         bool saveImpl(const String& path, const String& layout);
 
@@ -63,11 +65,24 @@ namespace Jam::Editor::State
 
         void unload();
 
-        String layout() const;
+        /**
+         * \brief Returns the tree node of the last loaded project.
+         *
+         * The node points into the parsed project file, and stays valid
+         * until releaseLayout, unload or the next load is called.
+         */
+        const XmlNode* layout() const;
+
+        void releaseLayout();
 
         const String& path() const;
     };
 
+    inline const XmlNode* ProjectManager::layout() const
+    {
+        return _layout;
+    }
+
     inline const String& ProjectManager::path() const
     {
         return _path;
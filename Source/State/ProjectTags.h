@@ -77,6 +77,8 @@ namespace Jam::Editor::State
     constexpr size_t ProjectFileTagsMax = FrameStackTagsMax +
                                           AreaLayoutTagsMax +
                                           (ProjectFileMax - ProjectFileStart) - 1;
+    constexpr size_t ProjectLayoutTagsMax = AreaLayoutTagsMax +
+                                            (ProjectFileMax - ProjectFileStart) - 1;
 
     constexpr TypeFilter FrameStackTags[FrameStackTagsMax] = {
         {     "stack", FrameStackTag}, // FrameStackTags
@@ -104,4 +106,13 @@ namespace Jam::Editor::State
         {"expression", ExpressionTag},
     };
 
+    // The project file without the stack, which is read with
+    // FrameStackSerialize instead of into nodes.
+    constexpr TypeFilter ProjectLayoutTags[ProjectLayoutTagsMax] = {
+        {   "jam", JamProjectTag}, // ProjectFileTags
+        {  "tree",       TreeTag}, // AreaLayoutTags
+        {  "leaf",       LeafTag},
+        {"branch",     BranchTag},
+    };
+
 }  // namespace Jam::Editor::State
@@ -20,6 +20,7 @@
 -------------------------------------------------------------------------------
 */
 #include "StringConverter.h"
+#include <algorithm>
 #include "Utils/Char.h"
 
 namespace Jam
@@ -126,17 +127,45 @@ namespace Jam
             Console::writeError("Failed to convert input string: ", str);
     }
 
+    template <typename T, typename Array>
+    void splitNumbers(const String& str, Array& dest, const I8 sep)
+    {
+        const U32 fields = U32(std::count(str.begin(), str.end(), (char)sep)) + 1;
+        dest.reserve(Clamp<U32>(fields, 0, MaxSplit));
+
+        StringView input(str);
+        while (!input.empty())
+        {
+            const size_t end   = input.find((char)sep);
+            StringView   field = input.substr(0, end);
+
+            if (end == StringView::npos)
+                input = {};
+            else
+                input.remove_prefix(end + 1);
+
+            while (!field.empty() && isWhiteSpace(field.front()))
+                field.remove_prefix(1);
+            while (!field.empty() && isWhiteSpace(field.back()))
+                field.remove_suffix(1);
+
+            // like the split it replaces, empty fields are skipped and
+            // fields that are not numbers read as zero
+            if (!field.empty())
+            {
+                T v{};
+                Char::fromChars(field, v);
+                dest.push_back(v);
+            }
+        }
+    }
+
     void StringConverter::toR32Array(
         const String& str,
         R32Array&     dest,
         const I8      sep)
     {
-        StringArray sa;
-        Su::splitRejectEmpty(sa, str, sep);
-
-        dest.reserve(Clamp<U32>(U32(sa.size()), 0, MaxSplit));
-        for (const auto& v : sa)
-            dest.push_back(Char::toFloat(v));
+        splitNumbers<R32>(str, dest, sep);
     }
 
     void StringConverter::toI32Array(
@@ -144,13 +173,7 @@ namespace Jam
         I32Array&     dest,
         const I8      sep)
     {
-        StringArray sa;
-        Su::splitRejectEmpty(sa, str, sep);
-
-        dest.reserve(Clamp<U32>(U32(sa.size()), 0, MaxSplit));
-
-        for (const auto& v : sa)
-            dest.push_back(Char::toInt32(v));
+        splitNumbers<I32>(str, dest, sep);
     }
 
 }  // namespace Jam
@@ -29,10 +29,30 @@
 #include "Utils/String.h"
 #include "Utils/StringConverter.h"
 #include "Xml/Node.h"
+#include "Xml/Reader.h"
 #include "Xml/Writer.h"
 
 namespace Jam
 {
+    namespace
+    {
+        Axis makeAxis(const I32Array& v, const Slice& defX, const Slice& defY)
+        {
+            Axis dest;
+            if (v.size() == 4)
+            {
+                dest.x = {v[0], v[1]};
+                dest.y = {v[2], v[3]};
+            }
+            else
+            {
+                dest.x = defX;
+                dest.y = defY;
+            }
+            return dest;
+        }
+    }  // namespace
+
     Color XmlConverter::toColor(const XmlNode* tag, const Color& def)
     {
         Color copy = def;
@@ -76,6 +96,21 @@ namespace Jam
         return copy;
     }
 
+    Vec2F XmlConverter::toVec2F(const String&    attr,
+                                const XmlReader& reader,
+                                const Vec2F&     def,
+                                const Vec2F&     minMax)
+    {
+        Vec2F copy = def;
+        if (const StringView value = reader.attribute(attr);
+            !value.empty())
+        {
+            Sc::toVec2F(String(value), copy);
+            copy.clamp(minMax);
+        }
+        return copy;
+    }
+
     R32 XmlConverter::toReal(const XmlNode* tag, const R32& def)
     {
         if (tag != nullptr)
@@ -159,21 +194,21 @@ namespace Jam
                               const Slice&   defX,
                               const Slice&   defY)
     {
-        Axis     dest;
         I32Array v;
         toIntArray(attr, tag, v);
+        return makeAxis(v, defX, defY);
+    }
 
-        if (v.size() == 4)
-        {
-            dest.x = {v[0], v[1]};
-            dest.y = {v[2], v[3]};
-        }
-        else
-        {
-            dest.x = defX;
-            dest.y = defY;
-        }
-        return dest;
+    Axis XmlConverter::toAxis(const String&    attr,
+                              const XmlReader& reader,
+                              const Slice&     defX,
+                              const Slice&     defY)
+    {
+        I32Array v;
+        if (const StringView val = reader.attribute(attr);
+            !val.empty())
+            Sc::toI32Array(String(val), v);
+        return makeAxis(v, defX, defY);
     }
 
     uint32_t XmlConverter::toIntFromBinary(const XmlNode* tag)
@@ -199,17 +234,22 @@ namespace Jam
         return result;
     }
 
+    void XmlConverter::configure(XmlWriter& writer, const I8 indent)
+    {
+        const Editor::PersistentSettings settings;
+
+        writer.setShowXmlHeader(false);
+        writer.setMinify(settings.minify());
+        writer.setIndent(settings.spaces());
+        writer.setIndentOffset(indent);
+    }
+
     void XmlConverter::toStream(OStream&       stream,
                                 const XmlNode* fromRoot,
                                 const I8       indent)
     {
-        const Editor::PersistentSettings settings;
-
         Xml::Writer log(fromRoot);
-        log.setShowXmlHeader(false);
-        log.setMinify(settings.minify());
-        log.setIndent(settings.spaces());
-        log.setIndentOffset(indent);
+        configure(log, indent);
         log.write(stream);
     }
 
@@ -47,6 +47,11 @@ namespace Jam
                              const Vec2F&   def    = {R32(0), 0},
                              const Vec2F&   minMax = {-UnitMax, UnitMax});
 
+        static Vec2F toVec2F(const String&    attr,
+                             const XmlReader& reader,
+                             const Vec2F&     def    = {R32(0), 0},
+                             const Vec2F&     minMax = {-UnitMax, UnitMax});
+
         static R32 toReal(const XmlNode* tag, const R32& def = 0);
 
         static int32_t toInt(const XmlNode* tag, const int32_t& def = 0);
@@ -71,8 +76,16 @@ namespace Jam
                            const Slice&   defX = {1, 1},
                            const Slice&   defY = {1, 1});
 
+        static Axis toAxis(const String&    attr,
+                           const XmlReader& reader,
+                           const Slice&     defX = {1, 1},
+                           const Slice&     defY = {1, 1});
+
         static uint32_t toIntFromBinary(const XmlNode* tag);
 
+        // Applies the minify and spacing settings to writer.
+        static void configure(XmlWriter& writer, I8 indent = 0);
+
         static void toStream(OStream& stream, const XmlNode* fromRoot, I8 indent = 0);
         static void toString(String& str, const XmlNode* fromRoot, I8 indent = 0);
     };
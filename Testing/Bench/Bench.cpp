@@ -0,0 +1,239 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Bench.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "Utils/Char.h"
+#include "Utils/StreamMethods.h"
+
+namespace
+{
+    std::atomic<Jam::U64> Allocations{0};
+
+    struct Entry
+    {
+        Jam::String         name;
+        Jam::Bench::Function fn;
+    };
+
+    std::vector<Entry>& entries()
+    {
+        static std::vector<Entry> registry;
+        return registry;
+    }
+
+    volatile Jam::R64 Sink = 0;
+}  // namespace
+
+void* operator new(const size_t size)
+{
+    Allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](const size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace Jam::Bench
+{
+    void add(const String& name, const Function& fn)
+    {
+        entries().push_back({name, fn});
+    }
+
+    U64 allocations()
+    {
+        return Allocations.load(std::memory_order_relaxed);
+    }
+
+    void keep(const R64 value)
+    {
+        Sink = value;
+    }
+
+    struct Options
+    {
+        String json;
+        String filter;
+        R64    minTime{0.5};
+    };
+
+    Result run(const Entry& entry, const Options& opts)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        Result res;
+        res.name = entry.name;
+
+        // warm up once, then double until the run is long enough to trust
+        {
+            State warm(1);
+            entry.fn(warm);
+        }
+
+        U64 iterations = 1;
+        for (;;)
+        {
+            State     state(iterations);
+            const U64 a0 = allocations();
+
+            const auto t0 = Clock::now();
+            entry.fn(state);
+            const R64 elapsed = std::chrono::duration<R64>(Clock::now() - t0).count();
+
+            const U64 a1 = allocations();
+
+            if (elapsed >= opts.minTime || iterations >= 0x40000000)
+            {
+                const R64 it       = R64(iterations);
+                res.iterations     = iterations;
+                res.nanoseconds    = elapsed * 1e9 / it;
+                res.itemsPerSecond = elapsed > 0 ? R64(state.items()) / elapsed : 0;
+                res.bytesPerSecond = elapsed > 0 ? R64(state.bytes()) / elapsed : 0;
+                res.allocations    = R64(a1 - a0) / it;
+                return res;
+            }
+
+            // aim past the minimum time, without growing more than 10x
+            const R64 scale = elapsed > 0 ? Clamp(opts.minTime * 1.4 / elapsed, 2.0, 10.0) : 10.0;
+            iterations      = U64(R64(iterations) * scale);
+        }
+    }
+
+    void writeJson(FILE* fp, const std::vector<Result>& results)
+    {
+        fprintf(fp, "{\n");
+        fprintf(fp, "  \"context\": {\n");
+        fprintf(fp, "    \"executable\": \"Intern.Bench\",\n");
+#ifdef NDEBUG
+        fprintf(fp, "    \"library_build_type\": \"release\"\n");
+#else
+        fprintf(fp, "    \"library_build_type\": \"debug\"\n");
+#endif
+        fprintf(fp, "  },\n");
+        fprintf(fp, "  \"benchmarks\": [\n");
+
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const Result& res = results[i];
+            fprintf(fp, "    {\n");
+            fprintf(fp, "      \"name\": \"%s\",\n", res.name.c_str());
+            fprintf(fp, "      \"iterations\": %llu,\n", (unsigned long long)res.iterations);
+            fprintf(fp, "      \"real_time\": %.3f,\n", res.nanoseconds);
+            fprintf(fp, "      \"time_unit\": \"ns\",\n");
+            fprintf(fp, "      \"items_per_second\": %.3f,\n", res.itemsPerSecond);
+            fprintf(fp, "      \"bytes_per_second\": %.3f,\n", res.bytesPerSecond);
+            fprintf(fp, "      \"allocations_per_iteration\": %.3f\n", res.allocations);
+            fprintf(fp, "    }%s\n", i + 1 < results.size() ? "," : "");
+        }
+
+        fprintf(fp, "  ]\n");
+        fprintf(fp, "}\n");
+    }
+
+    void usage()
+    {
+        printf("Usage: Intern.Bench [options]\n");
+        printf("  --filter=<text>   Run only the benchmarks containing text.\n");
+        printf("  --min-time=<sec>  Minimum time per benchmark (default 0.5).\n");
+        printf("  --json=<file>     Write the results as JSON to file.\n");
+    }
+
+}  // namespace Jam::Bench
+
+int main(int argc, char** argv)
+{
+    using namespace Jam;
+
+    Bench::Options opts;
+    for (int i = 1; i < argc; ++i)
+    {
+        const String arg = argv[i];
+        if (arg.rfind("--json=", 0) == 0)
+            opts.json = arg.substr(7);
+        else if (arg.rfind("--filter=", 0) == 0)
+            opts.filter = arg.substr(9);
+        else if (arg.rfind("--min-time=", 0) == 0)
+            opts.minTime = Char::toDouble(arg.substr(11), 0.5);
+        else
+        {
+            Bench::usage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    std::vector<Bench::Result> results;
+    for (const Entry& entry : entries())
+    {
+        if (!opts.filter.empty() && entry.name.find(opts.filter) == String::npos)
+            continue;
+
+        const Bench::Result res = Bench::run(entry, opts);
+        printf("%-40s %14.1f ns %14.0f items/s %10.2f allocs\n",
+               res.name.c_str(),
+               res.nanoseconds,
+               res.itemsPerSecond,
+               res.allocations);
+        results.push_back(res);
+    }
+
+    if (!opts.json.empty())
+    {
+        FILE* fp = fopen(opts.json.c_str(), "w");
+        if (!fp)
+        {
+            printf("failed to open %s\n", opts.json.c_str());
+            return 1;
+        }
+        Bench::writeJson(fp, results);
+        fclose(fp);
+    }
+    return 0;
+}
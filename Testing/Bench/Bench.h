@@ -0,0 +1,76 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+#include <functional>
+#include "Math/Real.h"
+#include "Utils/String.h"
+
+namespace Jam::Bench
+{
+    /**
+     * \brief Passed to a benchmark. The benchmark repeats its work
+     * iterations() times and reports how much it processed.
+     */
+    class State
+    {
+    private:
+        U64 _iterations{1};
+        U64 _items{0};
+        U64 _bytes{0};
+
+    public:
+        explicit State(const U64 iterations) :
+            _iterations(iterations) {}
+
+        U64 iterations() const { return _iterations; }
+
+        void addItems(const U64 nr) { _items += nr; }
+
+        void addBytes(const U64 nr) { _bytes += nr; }
+
+        U64 items() const { return _items; }
+
+        U64 bytes() const { return _bytes; }
+    };
+
+    using Function = std::function<void(State&)>;
+
+    struct Result
+    {
+        String name;
+        U64    iterations{0};
+        R64    nanoseconds{0};  // per iteration
+        R64    itemsPerSecond{0};
+        R64    bytesPerSecond{0};
+        R64    allocations{0};  // per iteration
+    };
+
+    // Registers a benchmark that runs when main is called.
+    void add(const String& name, const Function& fn);
+
+    // The number of calls to operator new made so far.
+    U64 allocations();
+
+    // Keeps the optimizer from discarding a computed value.
+    void keep(R64 value);
+
+}  // namespace Jam::Bench
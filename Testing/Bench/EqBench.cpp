@@ -0,0 +1,254 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Bench.h"
+#include "Equation/Program.h"
+#include "Equation/Statement.h"
+#include "Equation/StmtParser.h"
+#include "Equation/StmtScanner.h"
+#include "TestDirectory.h"
+#include "Utils/StreamMethods.h"
+
+using namespace Jam;
+
+namespace
+{
+    constexpr I16 MaxDepth = 0x800;
+    constexpr U32 Samples  = 1024;
+
+    String Poly(const int terms)
+    {
+        // a0 + a1*x + a2*x^2 + ... with constant coefficients
+        OutputStringStream oss;
+        oss << "1";
+        for (int i = 1; i < terms; ++i)
+            oss << "+" << (i % 7 + 1) << ".5*x^" << i % 3;
+        return oss.str();
+    }
+
+    String Trig(const int terms)
+    {
+        OutputStringStream oss;
+        oss << "sin(x)";
+        for (int i = 1; i < terms; ++i)
+        {
+            switch (i % 4)
+            {
+            case 0:
+                oss << "+sin(x*" << i << ")";
+                break;
+            case 1:
+                oss << "-cos(x/" << i << ")*b";
+                break;
+            case 2:
+                oss << "+atan2(x," << i << ")";
+                break;
+            default:
+                oss << "+sqrt(abs(tan(x+b)))";
+                break;
+            }
+        }
+        return oss.str();
+    }
+
+    String ReadFile(const String& localName)
+    {
+        InputFileStream fs;
+        fs.open(localName);
+        if (!fs.is_open())
+            return {};
+        OutputStringStream oss;
+        oss << fs.rdbuf();
+        return oss.str();
+    }
+
+    void Scan(Bench::State& state, const String& text)
+    {
+        for (U64 i = 0; i < state.iterations(); ++i)
+        {
+            Eq::StmtScanner sc;
+            sc.attach(StringView(text), PathUtil());
+
+            Eq::Token tok;
+            U64       nr = 0;
+            do
+            {
+                sc.scan(tok);
+                ++nr;
+            } while (tok.type() != Eq::TOK_EOF);
+
+            state.addItems(nr);
+            state.addBytes(text.size());
+        }
+    }
+
+    void Parse(Bench::State& state, const String& text)
+    {
+        Eq::StmtParser parse(MaxDepth);
+        for (U64 i = 0; i < state.iterations(); ++i)
+        {
+            parse.readText(text);
+            state.addItems(parse.symbols().size());
+            state.addBytes(text.size());
+        }
+    }
+
+    void Compile(Bench::State& state, const String& text)
+    {
+        InputStringStream ss(text);
+        Eq::StmtParser    parse(MaxDepth);
+        parse.read(ss);
+
+        for (U64 i = 0; i < state.iterations(); ++i)
+        {
+            Eq::Program prog;
+            prog.compile(parse.symbols());
+            state.addItems(1);
+        }
+    }
+
+    void EvalSymbols(Bench::State& state, const String& text)
+    {
+        InputStringStream ss(text);
+        Eq::StmtParser    parse(MaxDepth);
+        parse.read(ss);
+
+        Eq::Statement eval;
+        eval.set("b", 0.5);
+        for (U64 i = 0; i < state.iterations(); ++i)
+        {
+            eval.set("x", R64(i % Samples) * 0.01);
+            Bench::keep(eval.execute(parse.symbols()));
+        }
+        state.addItems(state.iterations());
+    }
+
+    void EvalScalar(Bench::State& state, const String& text)
+    {
+        InputStringStream ss(text);
+        Eq::StmtParser    parse(MaxDepth);
+        parse.read(ss);
+
+        Eq::Program prog;
+        prog.compile(parse.symbols());
+
+        Eq::Statement eval;
+        eval.bind(prog);
+        const U32 x = prog.indexOf("x");
+        const U32 b = prog.indexOf("b");
+        if (b != JtNpos32)
+            eval.setSlot(b, 0.5);
+
+        for (U64 i = 0; i < state.iterations(); ++i)
+        {
+            eval.setSlot(x, R64(i % Samples) * 0.01);
+            Bench::keep(eval.execute(prog));
+        }
+        state.addItems(state.iterations());
+    }
+
+    void EvalBatch(Bench::State& state, const String& text, const Eq::Backend backend)
+    {
+        InputStringStream ss(text);
+        Eq::StmtParser    parse(MaxDepth);
+        parse.read(ss);
+
+        Eq::Program prog;
+        prog.compile(parse.symbols());
+
+        Eq::Statement eval;
+        eval.setBackend(backend);
+        eval.bind(prog);
+        const U32 x = prog.indexOf("x");
+        const U32 b = prog.indexOf("b");
+        if (b != JtNpos32)
+            eval.setSlot(b, 0.5);
+
+        SimpleArray<R64> xs, ys;
+        xs.reserve(Samples);
+        ys.reserve(Samples);
+        for (U32 i = 0; i < Samples; ++i)
+        {
+            xs.push_back(R64(i) * 0.01);
+            ys.push_back(0);
+        }
+
+        for (U64 i = 0; i < state.iterations(); ++i)
+        {
+            eval.executeBatch(prog, x, xs.data(), ys.data(), Samples);
+            Bench::keep(ys[0]);
+        }
+        state.addItems(state.iterations() * Samples);
+    }
+
+    void EvalNative(Bench::State& state, const String& text)
+    {
+        EvalBatch(state, text, Eq::BackendNative);
+    }
+
+    void EvalInterpreter(Bench::State& state, const String& text)
+    {
+        EvalBatch(state, text, Eq::BackendInterpreter);
+    }
+
+    using Runner = void (*)(Bench::State&, const String&);
+
+    void Register(const String& name, const Runner fn, const String& text)
+    {
+        Bench::add(name, [fn, text](Bench::State& state)
+                   { fn(state, text); });
+    }
+
+    struct Registration
+    {
+        Registration()
+        {
+            for (const char* file : {"scan0.eq", "scan1.eq", "scan2.eq", "scan3.eq"})
+            {
+                const String text = ReadFile(String(ABSOLUTE_TEST_DIRECTORY) + file);
+                Register(String("Scan/") + file, Scan, text);
+            }
+
+            for (const int size : {4, 16, 64})
+            {
+                const String n    = std::to_string(size);
+                const String poly = Poly(size);
+                const String trig = Trig(size);
+
+                Register("Scan/Poly/" + n, Scan, poly);
+                Register("Parse/Poly/" + n, Parse, poly);
+                Register("Parse/Trig/" + n, Parse, trig);
+                Register("Compile/Poly/" + n, Compile, poly);
+                Register("Compile/Trig/" + n, Compile, trig);
+                Register("EvalSymbols/Poly/" + n, EvalSymbols, poly);
+                Register("EvalSymbols/Trig/" + n, EvalSymbols, trig);
+                Register("EvalScalar/Poly/" + n, EvalScalar, poly);
+                Register("EvalScalar/Trig/" + n, EvalScalar, trig);
+                Register("EvalBatch/Poly/" + n, EvalInterpreter, poly);
+                Register("EvalBatch/Trig/" + n, EvalInterpreter, trig);
+                Register("EvalNative/Poly/" + n, EvalNative, poly);
+                Register("EvalNative/Trig/" + n, EvalNative, trig);
+            }
+        }
+    };
+
+    const Registration Registered;
+}  // namespace
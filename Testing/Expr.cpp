@@ -1,17 +1,623 @@
 #include <cstdio>
+#if defined(_WIN32)
+    #include <windows.h>
+    #include <psapi.h>
+#elif defined(__linux__)
+    #include <unistd.h>
+#endif
+#include "Equation/Program.h"
 #include "Equation/Statement.h"
 #include "Equation/StmtParser.h"
 #include "Equation/StmtScanner.h"
 #include "ExprData.inl"
 #include "Math/Lg.h"
 #include "TestDirectory.h"
+#include "Utils/FileSystem.h"
+#include "Utils/MappedFile.h"
 #include "Utils/StreamMethods.h"
 #include "gtest/gtest.h"
 
 using namespace Jam;
 
+void TestDouble(R64 a, R64 b);
+
+///////////////////////////////////////////////////////////////////////////////
+
+GTEST_TEST(Expression, Dual000)
+{
+    Eq::StmtParser parse;
+    parse.readText("a*sin(x)^2 + exp(x/a) - sqrt(x)/x");
+
+    Eq::Program prog;
+    prog.compile(parse.symbols());
+
+    Eq::Statement eval;
+    eval.set("a", 3);
+
+    const U32 slot = prog.indexOf("x");
+    for (int i = 1; i < 32; ++i)
+    {
+        const R64      x = R64(i) * 0.25;
+        const Eq::Dual y = eval.executeDual(prog, slot, x);
+
+        eval.setSlot(slot, x);
+        EXPECT_DOUBLE_EQ(y.v, eval.execute(prog));
+        EXPECT_NEAR(y.d,
+                    6 * sin(x) * cos(x) + exp(x / 3) / 3 + 0.5 * pow(x, -1.5),
+                    1e-12);
+    }
+
+    // the slope is undefined where the value is
+    parse.readText("log(x) + 2^x");
+    prog.compile(parse.symbols());
+
+    Eq::Dual y = eval.executeDual(prog, 0, 2);
+    EXPECT_DOUBLE_EQ(y.d, 0.5 + 4 * log(2));
+
+    y = eval.executeDual(prog, 0, -1);
+    EXPECT_TRUE(std::isnan(y.v));
+    EXPECT_TRUE(std::isnan(y.d));
+}
+
+GTEST_TEST(Expression, Interval000)
+{
+    const struct
+    {
+        const char* text;
+        R64         lo, hi;
+        bool        continuous;
+    } cases[] = {
+        {"x*x-3*x", -2, 5, true},
+        {"sin(x)*2", 0.5, 2, true},
+        {"cos(x)+x^3", -4, 1, true},
+        {"sqrt(x)+log(x)", 0.5, 9, true},
+        {"1/(x-2)", 1, 3, false},
+        {"floor(x/2)", 0, 3, false},
+        {"tan(x)", 1, 2, false},
+        {"fmod(x, 3)", 1, 2, true},
+    };
+
+    Eq::StmtParser parse;
+    Eq::Program    prog;
+    Eq::Statement  eval;
+
+    for (const auto& c : cases)
+    {
+        parse.readText(c.text);
+        prog.compile(parse.symbols());
+
+        const U32          slot = prog.indexOf("x");
+        const Eq::Interval y    = eval.executeInterval(prog, slot, Eq::ivRange(c.lo, c.hi));
+        EXPECT_EQ(y.continuous, c.continuous) << c.text;
+
+        // every sample lies within the enclosure
+        for (int i = 0; i <= 64; ++i)
+        {
+            eval.setSlot(slot, c.lo + (c.hi - c.lo) * R64(i) / 64);
+
+            const R64 v = eval.execute(prog);
+            if (std::isfinite(v))
+            {
+                EXPECT_GE(v, y.lo) << c.text;
+                EXPECT_LE(v, y.hi) << c.text;
+            }
+        }
+    }
+
+    // the range of sin over a peak is exact up to rounding
+    parse.readText("sin(x)");
+    prog.compile(parse.symbols());
+    Eq::Interval y = eval.executeInterval(prog, 0, Eq::ivRange(0, 2));
+    EXPECT_NEAR(y.lo, 0, 1e-15);
+    EXPECT_DOUBLE_EQ(y.hi, 1);
+
+    // undefined everywhere, and undefined in part
+    parse.readText("sqrt(x)");
+    prog.compile(parse.symbols());
+    EXPECT_TRUE(Eq::ivIsEmpty(eval.executeInterval(prog, 0, Eq::ivRange(-3, -1))));
+    y = eval.executeInterval(prog, 0, Eq::ivRange(-1, 4));
+    EXPECT_FALSE(y.defined);
+    EXPECT_NEAR(y.hi, 2, 1e-15);
+
+    // assignments are not evaluated
+    parse.readText("y = x * 2");
+    prog.compile(parse.symbols());
+    y = eval.executeInterval(prog, prog.indexOf("x"), Eq::ivRange(0, 1));
+    EXPECT_FALSE(Eq::ivIsBounded(y));
+}
+
+GTEST_TEST(Expression, Error000)
+{
+    Eq::StmtParser parse;
+    parse.readText("sin(x, x) + 1");
+
+    Eq::Program prog;
+    EXPECT_FALSE(prog.tryCompile(parse.symbols()));
+    EXPECT_FALSE(prog.valid());
+    EXPECT_TRUE(prog.empty());
+    EXPECT_EQ(prog.error(), "expected 1 argument(s) to the supplied math function");
+    EXPECT_THROW(prog.compile(parse.symbols()), Exception);
+
+    // a failed program samples as zero without throwing
+    Eq::Statement eval;
+    R64           xs[4] = {1, 2, 3, 4};
+    R64           ys[4] = {5, 5, 5, 5};
+    EXPECT_NO_THROW(eval.executeBatch(prog, "x", xs, ys, 4));
+    for (const R64 y : ys)
+        EXPECT_EQ(y, 0);
+    EXPECT_EQ(eval.execute(prog), 0);
+    EXPECT_EQ(eval.execute(parse.symbols()), 0);
+
+    parse.readText("sin(x) + 1");
+    EXPECT_TRUE(prog.tryCompile(parse.symbols()));
+    EXPECT_TRUE(prog.valid());
+    EXPECT_TRUE(prog.error().empty());
+    eval.set("x", 0);
+    EXPECT_DOUBLE_EQ(eval.execute(prog), 1);
+}
+
+// Resident set size in bytes, or zero where it is not available.
+size_t ResidentBytes()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof pmc))
+        return pmc.WorkingSetSize;
+#elif defined(__linux__)
+    if (FILE* fp = fopen("/proc/self/statm", "r"))
+    {
+        unsigned long size = 0, resident = 0;
+        const int     nr   = fscanf(fp, "%lu %lu", &size, &resident);
+        fclose(fp);
+        if (nr == 2)
+            return resident * (size_t)sysconf(_SC_PAGESIZE);
+    }
+#endif
+    return 0;
+}
+
+GTEST_TEST(Expression, Group000)
+{
+    Eq::StmtParser parse;
+    parse.readText("y = [x, x + 1, x * 2, 4]");
+
+    Eq::Program prog;
+    prog.compile(parse.symbols());
+
+    Eq::Statement eval;
+    eval.bind(prog);
+    const U32 x = prog.indexOf("x");
+
+    // a list handle goes stale once a later execution makes lists
+    Eq::ValueList list;
+    eval.setSlot(x, 1);
+    const R64 first = eval.execute(prog);
+    EXPECT_EQ(first, Eq::InitialHash);
+    eval.execute(prog);
+    EXPECT_NE(eval.get("y"), first);
+
+    eval.get("y", list);
+    ASSERT_EQ(list.size(), 4);
+    EXPECT_EQ(list[0], 1);
+    EXPECT_EQ(list[1], 2);
+    EXPECT_EQ(list[2], 2);
+    EXPECT_EQ(list[3], 4);
+
+    // soak: the list storage is recycled, so memory stays flat
+    constexpr U32 Warmup = 100000;
+    constexpr U32 Total  = 2000000;
+
+    size_t base = 0;
+    for (U32 i = 0; i < Total; ++i)
+    {
+        eval.setSlot(x, R64(i));
+        eval.execute(prog);
+        if (i == Warmup)
+            base = ResidentBytes();
+    }
+
+    eval.get("y", list);
+    ASSERT_EQ(list.size(), 4);
+    EXPECT_EQ(list[0], Total - 1);
+    EXPECT_EQ(list[3], 4);
+
+    if (base == 0)
+    {
+        GTEST_SKIP() << "resident set size is not available";
+    }
+    EXPECT_LT(ResidentBytes(), base + (4 << 20));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
+GTEST_TEST(Expression, Program000)
+{
+    StringStream ss;
+    ss << "a=sin(x/2)*b-atan2(x,b)^2";
+
+    Eq::StmtParser parse;
+    parse.read(ss);
+
+    Eq::Program prog;
+    prog.compile(parse.symbols());
+    EXPECT_FALSE(prog.empty());
+    EXPECT_EQ(prog.names().size(), 3);
+    EXPECT_EQ(prog.indexOf("a"), 0);
+    EXPECT_EQ(prog.indexOf("x"), 1);
+    EXPECT_EQ(prog.indexOf("b"), 2);
+    EXPECT_EQ(prog.depth(), 1);
+
+    Eq::Statement eval;
+    eval.set("b", 3);
+    for (int i = 0; i < 16; ++i)
+    {
+        const R64 x = R64(i) * 0.25;
+        eval.set("x", x);
+
+        const R64 expected = sin(x / 2) * 3 - pow(atan2(x, 3), 2);
+        EXPECT_DOUBLE_EQ(eval.execute(prog), expected);
+        EXPECT_DOUBLE_EQ(eval.get("a"), expected);
+        EXPECT_DOUBLE_EQ(eval.execute(parse.symbols()), expected);
+    }
+
+    // stack underflow is reported when compiling
+    Eq::Symbol            add(Eq::Add);
+    const Eq::SymbolArray bad = {&add};
+    EXPECT_THROW(prog.compile(bad), Exception);
+    EXPECT_EQ(eval.execute(bad), 0);
+}
+
+GTEST_TEST(Expression, Batch000)
+{
+    StringStream ss;
+    ss << "sin(x)*cos(x/b)+x^2/(x-1)-tanh(x)";
+
+    Eq::StmtParser parse;
+    parse.read(ss);
+
+    Eq::Program prog;
+    prog.compile(parse.symbols());
+    EXPECT_FALSE(prog.hasSideEffects());
+
+    constexpr size_t n = 150;
+
+    Eq::ValueList xs, ys;
+    xs.resizeFast(n);
+    ys.resizeFast(n);
+    for (size_t i = 0; i < n; ++i)
+        xs[i] = -4.0 + R64(i) * 0.0625;
+
+    Eq::Statement eval;
+    eval.set("b", 3);
+    eval.executeBatch(prog, "x", xs.data(), ys.data(), n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        eval.set("x", xs[i]);
+        TestDouble(ys[i], eval.execute(prog));
+    }
+
+    // assignments fall back to scalar evaluation
+    ss.str("y=x*b");
+    ss.clear();
+    parse.read(ss);
+    prog.compile(parse.symbols());
+    EXPECT_TRUE(prog.hasSideEffects());
+
+    eval.executeBatch(prog, "x", xs.data(), ys.data(), n);
+    EXPECT_DOUBLE_EQ(ys[0], xs[0] * 3);
+    EXPECT_DOUBLE_EQ(eval.get("y"), xs[n - 1] * 3);
+}
+
+GTEST_TEST(Expression, Slot000)
+{
+    StringStream ss;
+    ss << "a*x+b";
+
+    Eq::StmtParser parse;
+    parse.read(ss);
+
+    Eq::Program prog;
+    prog.compile(parse.symbols());
+
+    const U32 a = prog.indexOf("a");
+    const U32 x = prog.indexOf("x");
+    const U32 b = prog.indexOf("b");
+    EXPECT_NE(x, JtNpos32);
+
+    Eq::Statement eval;
+    eval.set("b", 1);
+    eval.bind(prog);
+    eval.setSlot(a, 2);
+
+    for (int i = 0; i < 8; ++i)
+    {
+        eval.setSlot(x, R64(i));
+        EXPECT_DOUBLE_EQ(eval.execute(prog), 2.0 * i + 1);
+        EXPECT_DOUBLE_EQ(eval.getSlot(x), R64(i));
+    }
+
+    // slots and names refer to the same variable
+    eval.set("b", 5);
+    EXPECT_DOUBLE_EQ(eval.getSlot(b), 5);
+    eval.setSlot(b, 7);
+    EXPECT_DOUBLE_EQ(eval.get("b"), 7);
+
+    // recompiling with a different layout rebinds the slots
+    ss.str("x-b");
+    ss.clear();
+    parse.read(ss);
+    prog.compile(parse.symbols());
+
+    eval.bind(prog);
+    eval.setSlot(prog.indexOf("x"), 10);
+    EXPECT_DOUBLE_EQ(eval.execute(prog), 3);
+}
+
+GTEST_TEST(Expression, Inputs000)
+{
+    Eq::StmtParser parse;
+    parse.readText("a = 2");
+
+    Eq::Program assign;
+    assign.compile(parse.symbols());
+    EXPECT_TRUE(assign.hasSideEffects());
+
+    parse.readText("a*x");
+
+    Eq::Program plot;
+    plot.compile(parse.symbols());
+
+    // the assignment runs on the shared statement, and a worker
+    // that never saw it plots with the value it left behind
+    Eq::Statement shared;
+    shared.execute(assign);
+
+    const U32     x = plot.indexOf("x");
+    Eq::ValueList inputs;
+    shared.readInputs(plot, x, inputs);
+    ASSERT_EQ(inputs.size(), 1);
+    EXPECT_DOUBLE_EQ(inputs[0], 2);
+
+    Eq::Statement worker;
+    worker.writeInputs(plot, x, inputs);
+
+    R64 xs[4] = {-1, 0, 1, 2.5};
+    R64 ys[4];
+    worker.executeBatch(plot, x, xs, ys, 4);
+    for (int i = 0; i < 4; ++i)
+        EXPECT_DOUBLE_EQ(ys[i], 2 * xs[i]);
+}
+
+U32 CountOps(const Eq::Program& prog, const Eq::OpCode op)
+{
+    U32 nr = 0;
+    for (const Eq::Instruction& ins : prog.code())
+        nr += ins.op == op ? 1 : 0;
+    return nr;
+}
+
+GTEST_TEST(Expression, Fold000)
+{
+    const struct
+    {
+        const char* text;
+        R64         x;
+        R64         expected;
+        U32         size;
+    } cases[] = {
+        {          "2*3+x", 1.5,     7.5, 2},
+        {      "pow(x, 2)",   3,       9, 2},
+        {          "x^0.5",  16,       4, 2},
+        {            "x/4",   2,     0.5, 2},
+        {            "1/x",   4,    0.25, 2},
+        {            "1/x",   0,     NAN, 2},
+        {            "5-x",   2,       3, 2},
+        {            "x^1",   7,       7, 1},
+        {"sin(pi/2)*x+x*2",   3,       9, 5},
+        {  "atan2(1, 1)*4",   0,    Pi64, 1},
+    };
+
+    Eq::StmtParser parse;
+    Eq::Program    prog;
+    Eq::Statement  eval;
+
+    for (const auto& tc : cases)
+    {
+        StringStream ss(tc.text);
+        parse.read(ss);
+        prog.compile(parse.symbols());
+
+        EXPECT_EQ(prog.code().size(), tc.size) << tc.text;
+
+        eval.set("x", tc.x);
+        if (std::isnan(tc.expected))
+            EXPECT_TRUE(std::isnan(eval.execute(prog))) << tc.text;
+        else
+            EXPECT_DOUBLE_EQ(eval.execute(prog), tc.expected) << tc.text;
+    }
+
+    StringStream ss("pow(x, 2) + x^0.5 + x^3");
+    parse.read(ss);
+    prog.compile(parse.symbols());
+    EXPECT_EQ(CountOps(prog, Eq::OpSqr), 1);
+    EXPECT_EQ(CountOps(prog, Eq::OpSqrt), 0);
+    EXPECT_EQ(CountOps(prog, Eq::OpPowK), 2);
+    EXPECT_EQ(CountOps(prog, Eq::OpConst), 0);
+
+    // x^0.5 must keep pow's results where they differ from sqrt
+    StringStream half("x^0.5");
+    parse.read(half);
+    prog.compile(parse.symbols());
+
+    eval.set("x", -0.0);
+    R64 y = eval.execute(prog);
+    EXPECT_EQ(y, 0.0);
+    EXPECT_FALSE(std::signbit(y));
+
+    eval.set("x", -INFINITY);
+    y = eval.execute(prog);
+    EXPECT_TRUE(std::isinf(y));
+    EXPECT_GT(y, 0.0);
+}
+
+GTEST_TEST(Expression, Fold001)
+{
+    StringStream ss;
+    ss << "a*b*x+sin(a)/b-c^2";
+
+    Eq::StmtParser parse;
+    parse.read(ss);
+
+    Eq::Program prog;
+    prog.compile(parse.symbols());
+
+    Eq::Statement eval;
+    eval.set("a", 2);
+    eval.set("b", 4);
+    eval.set("c", 3);
+
+    // only x is left to load once the sliders are folded
+    const U32          x    = prog.indexOf("x");
+    const Eq::Program& spec = eval.specialize(prog, x);
+    EXPECT_EQ(CountOps(spec, Eq::OpLoad), 1);
+    EXPECT_EQ(spec.code().size(), 4);
+    EXPECT_EQ(spec.id(), prog.id());
+
+    R64 xs[100], ys[100];
+    for (int i = 0; i < 100; ++i)
+        xs[i] = R64(i) * 0.1;
+
+    eval.executeBatch(prog, x, xs, ys, 100);
+    for (int i = 0; i < 100; ++i)
+        EXPECT_DOUBLE_EQ(ys[i], 8 * xs[i] + sin(2.0) / 4 - 9);
+
+    // a changed slider is picked up by the next batch
+    eval.set("c", 1);
+    eval.executeBatch(prog, x, xs, ys, 100);
+    for (int i = 0; i < 100; ++i)
+    {
+        eval.set("x", xs[i]);
+        EXPECT_DOUBLE_EQ(ys[i], eval.execute(prog));
+    }
+}
+
+GTEST_TEST(Expression, Native000)
+{
+    const char* cases[] = {
+        "x*x-3*x+2",
+        "a*b*x+sin(a)/b-c^2",
+        "-abs(x-1)+sqrt(abs(x))",
+        "2/x+x/3-5-x",
+        "atan2(x,a)+fmod(x,b)+x%c",
+        "exp(x/4)*log(abs(x)+1)-log10(x^2+1)",
+        "floor(x)+ceil(x)+cosh(x/8)+sinh(x/8)+tanh(x)",
+        "acos(x/10)+asin(x/10)+atan(x)+tan(x)+cos(x)",
+        "x^a+x^0.5+x^2+b^x",
+        "a",
+        // deeper than there are xmm registers
+        "x+2*x+3*x+4*x+5*x+6*x+7*x+8*x+9*x+10*x+11*x+12*x+13*x+14*x+15*x+16*x+17*x+18*x",
+        "sin(x)+cos(x)/2+x*(x+(x-(x*(x+(x-(x*(x+(x-(x*(x+(x-(x*(x+(x-(x*(x+(x-sin(x))))))))))))))))))",
+    };
+
+    R64 xs[150], expected[150], ys[150];
+    for (int i = 0; i < 150; ++i)
+        xs[i] = R64(i - 75) * 0.13;
+
+    for (const char* text : cases)
+    {
+        StringStream ss;
+        ss << text;
+
+        Eq::StmtParser parse(0x800);
+        parse.read(ss);
+
+        Eq::Program prog;
+        prog.compile(parse.symbols());
+
+        Eq::Statement eval;
+        eval.set("a", 2);
+        eval.set("b", 4);
+        eval.set("c", 3);
+
+        const U32 x = prog.indexOf("x");
+        eval.setBackend(Eq::BackendInterpreter);
+        eval.executeBatch(prog, x, xs, expected, 150);
+
+        eval.setBackend(Eq::BackendNative);
+        eval.executeBatch(prog, x, xs, ys, 150);
+        for (int i = 0; i < 150; ++i)
+        {
+            if (std::isnan(expected[i]))
+                EXPECT_TRUE(std::isnan(ys[i]));
+            else
+                EXPECT_EQ(ys[i], expected[i]);
+        }
+
+        eval.setBackend(Eq::BackendCompare);
+        eval.executeBatch(prog, x, xs, ys, 150);
+        EXPECT_EQ(eval.mismatches(), 0);
+    }
+
+    // side effects are left to the interpreter
+    StringStream ss;
+    ss << "y=x+1";
+
+    Eq::StmtParser parse;
+    parse.read(ss);
+
+    Eq::Program prog;
+    prog.compile(parse.symbols());
+
+    Eq::Native native;
+    EXPECT_FALSE(native.compile(prog, prog.indexOf("x")));
+    EXPECT_TRUE(native.empty());
+}
+
+GTEST_TEST(Expression, Pool000)
+{
+    StringStream ss;
+    ss << "a=b+a*b";
+
+    Eq::StmtParser parse(0x800);
+    parse.read(ss);
+
+    // a b a b MUL ADD EQ
+    const Eq::SymbolArray& sym = parse.symbols();
+    EXPECT_EQ(sym.size(), 7);
+    EXPECT_EQ(sym[0]->name(), "a");
+    EXPECT_EQ(sym[1]->name(), "b");
+    EXPECT_EQ(sym[0]->nameIndex(), sym[2]->nameIndex());
+    EXPECT_EQ(sym[1]->nameIndex(), sym[3]->nameIndex());
+    EXPECT_NE(sym[0]->nameIndex(), sym[1]->nameIndex());
+    EXPECT_EQ(sym[4]->name(), "");
+
+    // names stay interned across parses
+    const U32 b = sym[1]->nameIndex();
+
+    // more symbols than fit in one block
+    ss.str(String{});
+    ss.clear();
+    ss << "b";
+    for (int i = 0; i < 150; ++i)
+        ss << "+1";
+    parse.read(ss);
+    EXPECT_EQ(parse.symbols().size(), 301);
+    EXPECT_EQ(parse.symbols()[0]->nameIndex(), b);
+
+    Eq::Statement eval;
+    eval.set("b", 2);
+    EXPECT_DOUBLE_EQ(eval.execute(parse.symbols()), 152);
+
+    // parsing again reuses the same blocks
+    const Eq::Symbol* first = parse.symbols()[0];
+    ss.str("b+1");
+    ss.clear();
+    parse.read(ss);
+    EXPECT_EQ(parse.symbols()[0], first);
+    EXPECT_DOUBLE_EQ(eval.execute(parse.symbols()), 3);
+}
+
 GTEST_TEST(Expression, Parse00d)
 {
     StringStream ss;
@@ -350,6 +956,162 @@ GTEST_TEST(Expression, Parse001)
 
 ///////////////////////////////////////////////////////////////////////////////
 
+GTEST_TEST(Expression, Scan6)
+{
+    // small files are read into a buffer
+    Eq::StmtScanner sc;
+    sc.open(GetTestFilePath("scan1.eq"));
+
+    Eq::Token tok;
+    sc.scan(tok);
+    EXPECT_EQ(tok.type(), Eq::TOK_MUL);
+    sc.scan(tok);
+    EXPECT_EQ(tok.type(), Eq::TOK_DIV);
+
+    // large files are mapped
+    OutputStringStream oss;
+    for (int i = 0; i < 0x2000; ++i)
+        oss << "x = " << i << "*sin(x)\n";
+    const String text = oss.str();
+
+    const String path = (StdFileSystem::temp_directory_path() / "Jam.Scan6.eq").string();
+    {
+        OutputFileStream out(path, std::ios::binary);
+        out << text;
+    }
+
+    {
+        const MappedFile map(path);
+        EXPECT_TRUE(map.isMapped());
+        EXPECT_EQ(map.view(), text);
+
+        Eq::StmtParser mapped, buffered;
+        mapped.read(path);
+        buffered.readText(text);
+        EXPECT_EQ(mapped.symbols().size(), buffered.symbols().size());
+    }
+    StdFileSystem::remove(path);
+
+    EXPECT_FALSE(MappedFile(path).isOpen());
+    EXPECT_THROW(sc.open(path), Exception);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+GTEST_TEST(Expression, Scan5)
+{
+    Eq::StmtParser parse;
+
+    String a, b;
+    parse.tokenize("y = 2*sin(x) + 0.5", a);
+    parse.tokenize("y=2 * sin( x )+0.50 # note", b);
+    EXPECT_EQ(a, b);
+
+    parse.tokenize("y = 2*sin(x2) + 0.5", b);
+    EXPECT_NE(a, b);
+    parse.tokenize("y = 2*sin(x) + 0.25", b);
+    EXPECT_NE(a, b);
+    parse.tokenize("y = 2*sin(x) - 0.5", b);
+    EXPECT_NE(a, b);
+
+    // the parser still works after tokenizing
+    Eq::StmtParser fresh;
+    fresh.readText("y = 2*sin(x) + 0.5");
+    parse.readText("y = 2*sin(x) + 0.5");
+    EXPECT_EQ(parse.symbols().size(), fresh.symbols().size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+GTEST_TEST(Expression, Scan4)
+{
+    for (const auto& [word, token, max] : Eq::Keywords)
+    {
+        if (word == nullptr)
+            continue;
+
+        Eq::StmtScanner sc;
+        sc.attach(StringView(word), PathUtil());
+
+        Eq::Token tok;
+        sc.scan(tok);
+        EXPECT_EQ(tok.type(), token);
+    }
+
+    // near misses stay identifiers
+    const String text = "atan3 sinx Sin si e mo log1";
+
+    Eq::StmtScanner sc;
+    sc.attach(StringView(text), PathUtil());
+
+    Eq::Token tok;
+    for (sc.scan(tok); tok.type() != Eq::TOK_EOF; sc.scan(tok))
+        EXPECT_EQ(tok.type(), Eq::TOK_IDENTIFIER);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+GTEST_TEST(Expression, Scan3)
+{
+    const String text = "alpha*sin(beta) + 1.5e2 # comment";
+
+    Eq::StmtScanner sc;
+    sc.attach(StringView(text), PathUtil());
+
+    const char* first = text.data();
+    const char* last  = text.data() + text.size();
+
+    Eq::Token tok;
+    sc.scan(tok);
+    EXPECT_EQ(tok.type(), Eq::TOK_IDENTIFIER);
+
+    // identifiers are slices of the source, not copies
+    StringView name = sc.string(tok.index());
+    EXPECT_EQ(name, "alpha");
+    EXPECT_TRUE(name.data() >= first && name.data() < last);
+
+    sc.scan(tok);
+    EXPECT_EQ(tok.type(), Eq::TOK_MUL);
+    sc.scan(tok);
+    EXPECT_EQ(tok.type(), Eq::TOK_SIN);
+    sc.scan(tok);
+    EXPECT_EQ(tok.type(), Eq::TOK_O_PAR);
+
+    sc.scan(tok);
+    EXPECT_EQ(tok.type(), Eq::TOK_IDENTIFIER);
+    name = sc.string(tok.index());
+    EXPECT_EQ(name, "beta");
+    EXPECT_EQ(name.data(), first + 10);
+
+    sc.scan(tok);
+    EXPECT_EQ(tok.type(), Eq::TOK_C_PAR);
+    sc.scan(tok);
+    EXPECT_EQ(tok.type(), Eq::TOK_PLUS);
+
+    sc.scan(tok);
+    EXPECT_EQ(tok.type(), Eq::TOK_FLOAT);
+    EXPECT_DOUBLE_EQ(150, sc.real(tok.index()));
+
+    sc.scan(tok);
+    EXPECT_EQ(tok.type(), Eq::TOK_EOF);
+
+    // the text path and the stream path build the same symbols
+    Eq::StmtParser a, b;
+    a.readText(text);
+
+    InputStringStream ss(text);
+    b.read(ss);
+
+    ASSERT_EQ(a.symbols().size(), b.symbols().size());
+    for (size_t i = 0; i < a.symbols().size(); ++i)
+    {
+        EXPECT_EQ(a.symbols()[i]->type(), b.symbols()[i]->type());
+        EXPECT_EQ(a.symbols()[i]->name(), b.symbols()[i]->name());
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 GTEST_TEST(Expression, Scan2)
 {
     const String fileName = GetTestFilePath("scan3.eq");
@@ -1,6 +1,7 @@
 #include "Utils/String.h"
 #include <gtest/gtest.h>
 #include "Math/Lg.h"
+#include "Utils/Char.h"
 
 using namespace Jam;
 
@@ -47,3 +48,39 @@ GTEST_TEST(String, Trim)
     EXPECT_EQ("111 111 1111  3", inp);
 
 }
+
+GTEST_TEST(String, Numbers)
+{
+    double d = -1;
+    EXPECT_EQ(Char::fromChars("1.5e2", d), 5u);
+    EXPECT_DOUBLE_EQ(d, 150.0);
+
+    // leading blanks and '+' are skipped, trailing text is not consumed
+    EXPECT_EQ(Char::fromChars("  +0.25,", d), 7u);
+    EXPECT_DOUBLE_EQ(d, 0.25);
+
+    d = 7;
+    EXPECT_EQ(Char::fromChars("abc", d), 0u);
+    EXPECT_DOUBLE_EQ(d, 7.0);
+
+    int32_t i = 0;
+    EXPECT_EQ(Char::fromChars("-42", i), 3u);
+    EXPECT_EQ(i, -42);
+
+    // shortest text that reads back exactly
+    EXPECT_EQ(Char::toString(0.1), "0.1");
+    EXPECT_EQ(Char::toString(0.1f), "0.1");
+    EXPECT_EQ(Char::toString(int32_t(-12)), "-12");
+    EXPECT_EQ(Char::toString(uint64_t(1) << 40), "1099511627776");
+
+    const double values[] = {1.0 / 3.0, 1e-300, 123456789.125, -2.5e17};
+    for (const double v : values)
+    {
+        double r = 0;
+        Char::fromChars(Char::toString(v), r);
+        EXPECT_EQ(r, v);
+    }
+
+    const float fv = 1.f / 3.f;
+    EXPECT_EQ(Char::toFloat(Char::toString(fv)), fv);
+}
@@ -0,0 +1,324 @@
+#include "Utils/Char.h"
+#include "Utils/StreamMethods.h"
+#include "Xml/Document.h"
+#include "Xml/Entities.h"
+#include "Xml/File.h"
+#include "Xml/Reader.h"
+#include "Xml/Writer.h"
+#include "gtest/gtest.h"
+
+using namespace Jam;
+
+enum XmlTestTags
+{
+    RootTag = 1,
+    ItemTag,
+    NoteTag,
+};
+
+constexpr TypeFilter XmlTestFilter[] = {
+    {"root", RootTag},
+    {"item", ItemTag},
+    {"note", NoteTag},
+};
+
+GTEST_TEST(Xml, Document000)
+{
+    Xml::Document doc(XmlTestFilter, 3);
+    doc.readText(R"(<?xml version="1.0"?>)"
+                 R"(<root name="a">)"
+                 R"(  <item x="1" y="2.5" z="-3"/>)"
+                 R"(  <skip><item x="9"/></skip>)"
+                 R"(  <note>hello world</note>)"
+                 R"(  <item x="2"/>)"
+                 R"(</root>)");
+
+    const Xml::Element* root = doc.root(RootTag);
+    ASSERT_NE(root, nullptr);
+    EXPECT_EQ(root->name(), "root");
+    EXPECT_EQ(root->attribute("name"), "a");
+    EXPECT_EQ(root->attribute("none", "def"), "def");
+
+    // skip is not in the filter, so it and its child are dropped
+    EXPECT_EQ(root->size(), 3u);
+    EXPECT_EQ(root->firstChildOf("skip"), nullptr);
+
+    const Xml::Element* item = root->firstChildOf(ItemTag);
+    ASSERT_NE(item, nullptr);
+    EXPECT_EQ(item->parent(), root);
+    EXPECT_EQ(item->integer("x"), 1);
+    EXPECT_EQ(item->float32("y"), 2.5f);
+    EXPECT_EQ(item->float64("z"), -3.0);
+    EXPECT_EQ(item->integer("w", 7), 7);
+
+    const Xml::Element* note = item->nextSiblingOf(NoteTag);
+    ASSERT_NE(note, nullptr);
+    EXPECT_EQ(note->text(), "hello world");
+    EXPECT_FALSE(note->hasChildren());
+
+    item = item->nextSiblingOf(ItemTag);
+    ASSERT_NE(item, nullptr);
+    EXPECT_EQ(item->integer("x"), 2);
+    EXPECT_EQ(item->next(), nullptr);
+
+    // interned names compare by address
+    const Xml::ElementName* x = doc.name("x");
+    ASSERT_NE(x, nullptr);
+    EXPECT_EQ(item->find(x), item->find("x"));
+    EXPECT_EQ(doc.name("missing"), nullptr);
+}
+
+GTEST_TEST(Xml, Document001)
+{
+    Xml::Document doc;
+    EXPECT_THROW(doc.readText("<a><b></a>"), Exception);
+    EXPECT_THROW(doc.readText(R"(<a x="1" x="2"/>)"), Exception);
+
+    OutputStringStream oss;
+    oss << "<list>";
+    for (int i = 0; i < 20000; ++i)
+        oss << R"(<v name="v)" << i << R"(" value="1.5" range="-10,10"/>)";
+    oss << "</list>";
+
+    doc.readText(oss.str());
+    const Xml::Element* list = doc.root("list");
+    ASSERT_NE(list, nullptr);
+    EXPECT_EQ(list->size(), 20000u);
+
+    // the whole tree is a few arena blocks
+    EXPECT_LT(doc.arena().blocks(), 16u);
+
+    // it writes the same text Xml::File reads
+    OutputStringStream out;
+    doc.write(out, Xml::Minify);
+
+    Xml::File fp;
+    fp.readText(out.str());
+    EXPECT_EQ(fp.root("list")->size(), 20000u);
+    EXPECT_EQ(fp.root("list")->at(19999)->attribute("name"), "v19999");
+}
+
+GTEST_TEST(Xml, Reader000)
+{
+    const String text = R"(<?xml version="1.0"?>)"
+                        R"(<root name="a">)"
+                        R"(  <item x="1" y="2.5"/>)"
+                        R"(  <skip><item x="9"/></skip>)"
+                        R"(  <note>hello world</note>)"
+                        R"(  <item x="2"><note>inner</note></item>)"
+                        R"(</root>)";
+
+    Xml::Reader reader(XmlTestFilter, 3);
+    reader.readText(text);
+
+    OutputStringStream events;
+    while (reader.next())
+    {
+        switch (reader.event())
+        {
+        case Xml::EventStartElement:
+            events << '<' << reader.name() << reader.code() << reader.depth();
+            break;
+        case Xml::EventAttribute:
+            events << ' ' << reader.name() << '=' << reader.value();
+            break;
+        case Xml::EventText:
+            events << '[' << reader.value() << ']';
+            break;
+        case Xml::EventEndElement:
+            events << '/' << reader.name() << reader.depth() << '>';
+            break;
+        default:
+            break;
+        }
+    }
+
+    // skip is not in the filter, so it and its child are not reported
+    EXPECT_EQ(events.str(),
+              "<root11 name=a"
+              "<item22 x=1 y=2.5/item2>"
+              "<note32[hello world]/note2>"
+              "<item22 x=2<note33[inner]/note3>/item2>"
+              "/root1>");
+
+    // attributes can be read at the start of an element, and
+    // skip moves past everything below it
+    reader.readText(text);
+
+    int64_t sum = 0;
+    while (reader.next())
+    {
+        if (reader.event() == Xml::EventStartElement && reader.isTypeOf(ItemTag))
+        {
+            sum += reader.integer("x");
+            EXPECT_EQ(reader.float32("w", 3.f), 3.f);
+            reader.skip();
+            EXPECT_EQ(reader.event(), Xml::EventEndElement);
+            EXPECT_TRUE(reader.isTypeOf(ItemTag));
+        }
+        EXPECT_FALSE(reader.event() == Xml::EventText && reader.value() == "inner");
+    }
+    EXPECT_EQ(sum, 3);
+
+    EXPECT_THROW(
+        {
+            reader.readText("<root><item></root>");
+            while (reader.next())
+                ;
+        },
+        Exception);
+
+    EXPECT_THROW(
+        {
+            reader.readText("<root><item>");
+            while (reader.next())
+                ;
+        },
+        Exception);
+}
+
+GTEST_TEST(Xml, Reader001)
+{
+    class Counter final : public Xml::ReaderHandler
+    {
+    public:
+        size_t elements{0}, attributes{0}, ends{0};
+
+        void startElement(const Xml::Reader& reader) override
+        {
+            if (reader.isTypeOf(ItemTag))
+                ++elements;
+        }
+
+        void attribute(const StringView&, const StringView&) override
+        {
+            ++attributes;
+        }
+
+        void endElement(const Xml::Reader&) override
+        {
+            ++ends;
+        }
+    };
+
+    OutputStringStream oss;
+    oss << "<root>";
+    for (int i = 0; i < 20000; ++i)
+        oss << R"(<item name="v)" << i << R"(" value="1.5"/>)";
+    oss << "</root>";
+
+    const String text = oss.str();
+
+    Xml::Reader reader(XmlTestFilter, 3);
+    reader.readText(text);
+
+    Counter counter;
+    reader.dispatch(counter);
+    EXPECT_EQ(counter.elements, 20000u);
+    EXPECT_EQ(counter.attributes, 40000u);
+    EXPECT_EQ(counter.ends, 20001u);
+}
+
+GTEST_TEST(Xml, Writer000)
+{
+    OutputStringStream oss;
+
+    Xml::Writer writer;
+    writer.setShowXmlHeader(false);
+    writer.begin(oss);
+    writer.beginElement("root");
+    writer.attribute("name", R"(a & <b> "q" 'p')");
+    writer.beginElement("item");
+    writer.attribute("x", 1);
+    writer.attribute("y", 2.5f);
+    writer.attribute("axis", {1u, 2u, 3u, 4u});
+    writer.endElement();
+    writer.beginElement("note");
+    writer.text("x < y & z");
+    writer.endElement();
+    writer.end();
+
+    const String text = oss.str();
+    EXPECT_EQ(text,
+              R"(<root name="a &amp; &lt;b&gt; &quot;q&quot; &apos;p&apos;">)"
+              R"(<item x="1" y="2.5" axis="1, 2, 3, 4"/>)"
+              R"(<note>x &lt; y &amp; z</note>)"
+              R"(</root>)");
+
+    // each parser decodes the entities that were written
+    Xml::File file;
+    file.readText(text);
+    const Xml::Node* root = file.root("root");
+    ASSERT_NE(root, nullptr);
+    EXPECT_EQ(root->attribute("name"), R"(a & <b> "q" 'p')");
+
+    Xml::Document doc(XmlTestFilter, 3);
+    doc.readText(text);
+    const Xml::Element* element = doc.root(RootTag);
+    ASSERT_NE(element, nullptr);
+    EXPECT_EQ(element->attribute("name"), R"(a & <b> "q" 'p')");
+    EXPECT_EQ(element->firstChildOf(NoteTag)->text(), "x < y & z");
+
+    Xml::Reader reader(XmlTestFilter, 3);
+    reader.readText(text);
+    ASSERT_TRUE(reader.next());
+    EXPECT_EQ(reader.attribute("name"), R"(a & <b> "q" 'p')");
+    while (reader.next() && reader.event() != Xml::EventText)
+        ;
+    EXPECT_EQ(reader.value(), "x < y & z");
+
+    String decoded;
+    Xml::unescape(decoded, "&#65;&#x42;&unknown;&amp");
+    EXPECT_EQ(decoded, "AB&unknown;&amp");
+}
+
+GTEST_TEST(Xml, Writer001)
+{
+    Xml::Node root("root");
+    Xml::Node* item = new Xml::Node("item");
+    item->insert("x", 1);
+    root.addChild(item);
+
+    Xml::Node* note = new Xml::Node("note");
+    note->text("hello");
+    root.addChild(note);
+
+    String text;
+    Xml::Writer::toString(text, &root, false, 2);
+    EXPECT_EQ(text,
+              "<root>\n"
+              "  <item x=\"1\"/>\n"
+              "  <note>hello</note>\n"
+              "</root>\n");
+
+    // large documents reach the stream in blocks
+    // but the output is unchanged
+    OutputStringStream oss;
+    Xml::Writer        writer;
+    writer.setMinify(false);
+    writer.begin(oss);
+    writer.beginElement("root");
+    for (int i = 0; i < 20000; ++i)
+    {
+        writer.beginElement("item");
+        writer.attribute("value", (R32)i * 0.5f);
+        writer.endElement();
+    }
+    writer.end();
+
+    text = oss.str();
+    EXPECT_GT(text.size(), Xml::Writer::FlushSize);
+
+    Xml::Reader reader(XmlTestFilter, 3);
+    reader.readText(text);
+    size_t count = 0;
+    while (reader.next())
+    {
+        if (reader.event() == Xml::EventStartElement && reader.isTypeOf(ItemTag))
+        {
+            EXPECT_EQ(reader.float32("value"), (R32)count * 0.5f);
+            ++count;
+        }
+    }
+    EXPECT_EQ(count, 20000u);
+}